@@ -3,4 +3,5 @@ IncludeDirs={}
 IncludeDirs["raylib"] = "%{wks.location}/Engine/vendor/raylib/src"
 IncludeDirs["imgui"] = "%{wks.location}/Engine/vendor/imgui/"
 IncludeDirs["rlImGui"] = "%{wks.location}/Engine/vendor/rlImGui/"
-IncludeDirs["eigen"] = "%{wks.location}/Engine/vendor/eigen/"
\ No newline at end of file
+IncludeDirs["eigen"] = "%{wks.location}/Engine/vendor/eigen/"
+IncludeDirs["XPBDCore"] = "%{wks.location}/XPBDCore/src"
\ No newline at end of file
@@ -9,12 +9,14 @@ project "Engine"
     location(projectLocation)
 
     dependson {
+       "XPBDCore",
        "raylib",
        "imgui",
        "rlImGui"
     }
 
     links{
+       "XPBDCore",
        "raylib",
        "imgui",
        "rlImGui"
@@ -27,6 +29,7 @@ project "Engine"
 
     includedirs {
         "src",
+        "%{IncludeDirs.XPBDCore}",
         "%{IncludeDirs.imgui}",
         "%{IncludeDirs.raylib}",
         "%{IncludeDirs.rlImGui}",
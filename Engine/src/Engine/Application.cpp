@@ -1,8 +1,10 @@
 #include "Application.h"
 
 #include <iostream>
+#include <mutex>
 
 #include "Scene.h"
+#include "Simulation/JobSystem.h"
 
 #include "raylib.h"
 #include "raymath.h"
@@ -18,6 +20,7 @@
 #include "Scenes/CubeRotationalScene.h"
 #include "Scenes/CubeHingeScene.h"
 #include "Scenes/DoorScene.h"
+#include "Scenes/BoxStackScene.h"
 
 #include "Utils/PathUtils.h"
 
@@ -145,9 +148,13 @@ namespace Engine
 
 		rlImGuiShutdown();
 
+		// Joins the simulation thread, before the scenes it steps go away
+		m_SimualtionControls.Shutdown();
 		m_SceneManager.UnloadAll();
 		CleanupApplicationResources();
 
+		Simulation::JobSystem::Get().Shutdown();
+
 		CloseWindow();
 	}
 
@@ -195,6 +202,7 @@ namespace Engine
 		m_SceneManager.LoadScene<Scenes::CubeRotationalScene>(Scenes::CubeRotationalSceneName);
 		m_SceneManager.LoadScene<Scenes::CubeHingeScene>(Scenes::CubeHingeSceneName);
 		m_SceneManager.LoadScene<Scenes::DoorScene>(Scenes::DoorSceneName);
+		m_SceneManager.LoadScene<Scenes::BoxStackScene>(Scenes::BoxStackSceneName);
 
 		m_IsRunning = true;
 
@@ -208,6 +216,9 @@ namespace Engine
 			return;
 		}
 
+		// The simulation thread waits while the scene samples its inputs and reacts to the controls.
+		std::lock_guard<std::mutex> sceneLock(m_SceneManager.CurrentScene()->GetMutex());
+
 		m_DebugDrawing.PreRender(deltaTime);
 
 		m_SceneManager.CurrentScene()->ProcessEvents();
@@ -227,6 +238,7 @@ namespace Engine
 		BeginDrawing();
 		ClearBackground(BLACK);
 
+		// The scene draws from its snapshots, so the simulation thread keeps stepping meanwhile.
 		if (m_SceneManager.HasValidScene())
 		{
 			std::shared_ptr<Scene> currentScene = m_SceneManager.CurrentScene();
@@ -263,7 +275,11 @@ namespace Engine
 
 			ImGui::End();
 
-			currentScene->DrawEditor();
+			{
+				// The editor reads and writes the simulation state directly.
+				std::lock_guard<std::mutex> sceneLock(currentScene->GetMutex());
+				currentScene->DrawEditor();
+			}
 
 			m_SimualtionControls.DrawControls();
 
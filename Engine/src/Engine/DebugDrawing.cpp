@@ -4,11 +4,18 @@
 #include "Utils/EigenToRaylib.h"
 #include "Engine/Application.h"
 
+#include "Constraints/PositionalConstraint.h"
+#include "Constraints/HingeConstraint.h"
+#include "Collision/ContactManifold.h"
+
+#include <algorithm>
+#include <cfloat>
+
 namespace Engine
 {
 	static const char* EnumToName(DebugFlags flag)
 	{
-		constexpr const char* names[] = { "Lights", "Force", "Constraints" };
+		constexpr const char* names[] = { "Lights", "Force", "Constraints", "Contacts" };
 		if (flag < 0 || flag >= DEBUG_FLAGS_MAX)
 		{
 			return "";
@@ -16,7 +23,7 @@ namespace Engine
 		return names[flag];
 	}
 
-	std::array<bool, DEBUG_FLAGS_MAX> DebugDrawing::s_Flags = { false, true, true };
+	std::array<bool, DEBUG_FLAGS_MAX> DebugDrawing::s_Flags = { false, true, true, false };
 
 	std::array<DebugDrawing::DebugLine, MAX_DEBUG_SHAPES> DebugDrawing::s_DebugLines;
 	int DebugDrawing::s_LinePointer = 0;
@@ -160,6 +167,11 @@ namespace Engine
 		s_SpherePointer--;
 	}
 
+	bool DebugDrawing::IsEnabled(DebugFlags flag)
+	{
+		return s_Flags[flag];
+	}
+
 	void DebugDrawing::DrawLightMarker(Color color, Eigen::Vector3f origin, float lifetime)
 	{
 		using namespace Utils::Math;
@@ -230,4 +242,96 @@ namespace Engine
 		AddLine(RayToLine(Ray{ ToVector3(forcePosition), ToVector3(s_ForceScale * direction) }, color, lifetime));
 		AddSphere(DebugSphere{ ToVector3(forcePosition), s_MarkerScale, color, lifetime, false });
 	}
+
+	void DebugDrawing::DrawForceMarkers(const Simulation::TransformSnapshot& snapshot, const std::vector<Eigen::Vector3f>& positions)
+	{
+		if (!s_Flags[DebugFlags::FORCES])
+		{
+			return;
+		}
+
+		// No forces were recorded before the first step.
+		const size_t numBodies = std::min(snapshot.Forces.size(), positions.size());
+		for (Simulation::BodyHandle body = 0; body < numBodies; ++body)
+		{
+			if ((snapshot.Flags[body] & Simulation::BODY_FLAG_STATIC) == 0)
+			{
+				DrawForceMarker(BLUE, positions[body], snapshot.Rotations[body], positions[body], snapshot.Forces[body], false, -1.0f, 0.0f);
+			}
+		}
+	}
+
+	void DebugDrawing::DrawConstraint(const Simulation::PositionalConstraint& constraint, const std::vector<Eigen::Vector3f>& positions, const std::vector<Eigen::Quaternionf>& rotations)
+	{
+		using namespace Utils::Math;
+
+		if (constraint.Body1 == Simulation::INVALID_BODY_HANDLE || constraint.Body2 == Simulation::INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		Color constraintColor = RED;
+
+		const Eigen::Vector3f& position1 = positions[constraint.Body1];
+		const Eigen::Vector3f& position2 = positions[constraint.Body2];
+		const Eigen::Vector3f deltaX = (position1 - position2) - constraint.TargetDistance.ToEigen();
+		const float errorDistSq = deltaX.squaredNorm();
+
+		if (errorDistSq <= FLT_EPSILON)
+		{
+			constraintColor = GREEN;
+		}
+
+		DrawDebugLine(ToVector3(position1), ToVector3(position2), constraintColor, 0.0f);
+
+		if (constraint.LocalR1.ToEigen().isZero() && constraint.LocalR2.ToEigen().isZero())
+		{
+			return;
+		}
+
+		const Eigen::Vector3f worldR1 = rotations[constraint.Body1].toRotationMatrix() * constraint.LocalR1.ToEigen();
+		const Eigen::Vector3f worldR2 = rotations[constraint.Body2].toRotationMatrix() * constraint.LocalR2.ToEigen();
+
+		DrawDebugLine(ToVector3(position1 + worldR1), ToVector3(position2 + worldR2), YELLOW, 0.0f);
+	}
+
+	void DebugDrawing::DrawConstraint(const Simulation::HingeConstraint& constraint, const std::vector<Eigen::Vector3f>& positions, const std::vector<Eigen::Quaternionf>& rotations)
+	{
+		using namespace Utils::Math;
+
+		if (constraint.Body1 == Simulation::INVALID_BODY_HANDLE || constraint.Body2 == Simulation::INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		const Eigen::Vector3f& position1 = positions[constraint.Body1];
+		const Eigen::Vector3f& position2 = positions[constraint.Body2];
+
+		Eigen::Vector3f AlignAxis1World = rotations[constraint.Body1].toRotationMatrix() * constraint.E1AlignAxis.ToEigen().normalized();
+		Eigen::Vector3f AlignAxis2World = rotations[constraint.Body2].toRotationMatrix() * constraint.E2AlignAxis.ToEigen().normalized();
+		Eigen::Vector3f LimitAxis1World = rotations[constraint.Body1].toRotationMatrix() * constraint.E1LimitAxis.ToEigen().normalized();
+		Eigen::Vector3f LimitAxis2World = rotations[constraint.Body2].toRotationMatrix() * constraint.E2LimitAxis.ToEigen().normalized();
+
+		DrawDebugLine(ToVector3(position1), ToVector3(position1 + 5 * AlignAxis1World), GREEN, 0.0f);
+		DrawDebugLine(ToVector3(position2), ToVector3(position2 + 5 * AlignAxis2World), GREEN, 0.0f);
+
+		DrawDebugLine(ToVector3(position1), ToVector3(position1 + 5 * LimitAxis1World), RED, 0.0f);
+		DrawDebugLine(ToVector3(position2), ToVector3(position2 + 5 * LimitAxis2World), RED, 0.0f);
+	}
+	void DebugDrawing::DrawContacts(const Simulation::ContactManifold& manifold)
+	{
+		using namespace Utils::Math;
+
+		if (!s_Flags[DebugFlags::CONTACTS])
+		{
+			return;
+		}
+
+		for (uint32_t i = 0; i < manifold.NumPoints; ++i)
+		{
+			const Simulation::ContactPoint& contact = manifold.Points[i];
+			AddSphere(DebugSphere{ ToVector3(contact.PointOnBody2), 0.5f * s_MarkerScale, ORANGE, 0.0f, false });
+			AddLine(RayToLine(Ray{ ToVector3(contact.PointOnBody2), ToVector3(s_ForceScale * manifold.Normal) }, ORANGE, 0.0f));
+		}
+	}
 }
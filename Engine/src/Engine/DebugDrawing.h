@@ -1,9 +1,16 @@
 #pragma once
 #include <array>
 #include "raylib.h"
-#include "Engine/Entity.h"
+#include "Simulation/SnapshotBuffer.h"
 #include <Eigen/Dense>
 
+namespace Simulation
+{
+    struct PositionalConstraint;
+    struct HingeConstraint;
+    struct ContactManifold;
+}
+
 namespace Engine
 {
     constexpr const size_t MAX_DEBUG_SHAPES = 100;
@@ -13,6 +20,7 @@ namespace Engine
         LIGHTS,
         FORCES,
         CONSTRAINTS,
+        CONTACTS,
         DEBUG_FLAGS_MAX
     };
 
@@ -45,6 +53,8 @@ namespace Engine
             bool isLocal = false,
             float minLength = -1.0f,
             float lifetime = -1.0f);
+        // Net force of every dynamic body in the snapshot, drawn at its render position
+        static void DrawForceMarkers(const Simulation::TransformSnapshot& snapshot, const std::vector<Eigen::Vector3f>& positions);
 
         static void DrawLightMarker(Color color, Eigen::Vector3f origin, float lifetime = -1.0f);
         static void DrawLightMarker(Color color, Vector3 origin, float lifetime = -1.0f);
@@ -53,6 +63,12 @@ namespace Engine
 
         static void DrawDebugSphere(Vector3 center, float radius, Color color, float lifetime = -1.0f, bool wireframe = false);
 
+        static void DrawConstraint(const Simulation::PositionalConstraint& constraint, const std::vector<Eigen::Vector3f>& positions, const std::vector<Eigen::Quaternionf>& rotations);
+        static void DrawConstraint(const Simulation::HingeConstraint& constraint, const std::vector<Eigen::Vector3f>& positions, const std::vector<Eigen::Quaternionf>& rotations);
+        static void DrawContacts(const Simulation::ContactManifold& manifold);
+
+        static bool IsEnabled(DebugFlags flag);
+
     protected:
         bool DrawSettings();
         void PreRender(const float deltaTime);
@@ -6,16 +6,16 @@
 #include "rlImGui.h"
 #include "raymath.h"
 
+#include <algorithm>
+
 #include "CameraControls.h"
 #include "SimulationControls.h"
 
 namespace Engine
 {
 	Scene::Scene(std::string sceneName)
-		:m_SceneName(sceneName), m_SceneCamera({ 0 })
+		:m_SceneName(sceneName), m_ViewportTexture({ 0 }), m_SceneCamera({ 0 })
 	{
-		m_ViewportTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-
 		m_SceneCamera.position = Vector3{ 0.0f, 10.0f, 10.0f };
 		m_SceneCamera.target = Vector3{ 0.0f, 0.0f, 0.0f };
 		m_SceneCamera.up = Vector3{ 0.0f, 1.0f, 0.0f };
@@ -26,18 +26,31 @@ namespace Engine
 
 	Scene::~Scene()
 	{
-		UnloadRenderTexture(m_ViewportTexture);
+		if (IsRenderTextureReady(m_ViewportTexture))
+		{
+			UnloadRenderTexture(m_ViewportTexture);
+		}
 	}
 
 	void Scene::Init()
 	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
 		OnInit();
+		ResetSteps();
+		m_Forces.clear();
+		m_Snapshots.Reset();
+
+		// Drawing never falls back to the bodies, so the reset state is published right away.
+		PublishSnapshot();
+		UpdateRenderTransforms(0.0f, false);
 		m_IsDirty = true;
 	}
 
 	void Scene::ProcessEvents()
 	{
 		m_IsDirty |= Utils::Camera::UpdateCamera(&m_SceneCamera);
+		OnProcessEvents();
 	}
 
 	void Scene::Update(const float deltaTime)
@@ -47,20 +60,7 @@ namespace Engine
 
 	void Scene::Simulate(const float deltaTime)
 	{
-		float dt = deltaTime;
-		if (m_OverrideDeltaTime)
-		{
-			while (m_Accumulator > m_DeltaTime)
-			{
-				HandleXPBDLoop(m_DeltaTime);
-				m_Accumulator -= m_DeltaTime;
-			}
-			m_Accumulator += deltaTime;
-		}
-		else
-		{
-			HandleXPBDLoop(dt);
-		}
+		PhysicsScene::Simulate(deltaTime);
 		m_IsDirty = true;
 	}
 
@@ -72,16 +72,32 @@ namespace Engine
 	void Scene::Draw()
 	{
 		OnDraw();
+
+		const Simulation::TransformSnapshot& snapshot = m_Snapshots.GetCurrent();
+		DebugDrawing::DrawForceMarkers(snapshot, m_RenderPositions);
+		for (const Simulation::ContactManifold& manifold : snapshot.Contacts)
+		{
+			DebugDrawing::DrawContacts(manifold);
+		}
+
 		m_IsDirty = false;
 	}
 
 	void Scene::HandleWindowResize()
 	{
-		UnloadRenderTexture(m_ViewportTexture);
-		m_ViewportTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+		if (IsRenderTextureReady(m_ViewportTexture))
+		{
+			UnloadRenderTexture(m_ViewportTexture);
+			LoadViewportTexture();
+		}
 		m_IsDirty = true;
 	}
 
+	void Scene::LoadViewportTexture()
+	{
+		m_ViewportTexture = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+	}
+
 	bool Scene::ShouldRender() const
 	{
 		return m_IsDirty;
@@ -107,28 +123,93 @@ namespace Engine
 		return m_ViewportTexture;
 	}
 
-	const int Scene::GetSubsteps() const
+	const Camera& Scene::GetSceneCamera() const
 	{
-		return m_Substeps;
+		return m_SceneCamera;
 	}
 
-	const int Scene::GetNumPosIterations() const
+	void Scene::MarkDirty()
 	{
-		return m_NumPosIterations;
+		m_IsDirty = true;
 	}
 
-	const Camera& Scene::GetSceneCamera() const
+	std::mutex& Scene::GetMutex()
 	{
-		return m_SceneCamera;
+		return m_Mutex;
 	}
 
-	void Scene::MarkDirty()
+	void Scene::PublishSnapshot()
 	{
-		m_IsDirty = true;
+		m_Snapshots.BeginWrite().Capture(m_Bodies, m_Forces, GetContacts(), GetStepCount());
+		m_Snapshots.Publish();
+	}
+
+	void Scene::UpdateRenderTransforms(const float deltaTime, const bool interpolate)
+	{
+		if (m_Snapshots.Acquire())
+		{
+			m_SnapshotAge = 0.0f;
+			m_IsDirty = true;
+		}
+		else
+		{
+			m_SnapshotAge += deltaTime;
+		}
+
+		const float alpha = interpolate ? std::min(m_SnapshotAge / GetFixedDeltaTime(), 1.0f) : 1.0f;
+		Simulation::InterpolateSnapshots(m_Snapshots.GetPrevious(), m_Snapshots.GetCurrent(), alpha, m_RenderPositions, m_RenderRotations);
+
+		// The blend moves every frame, not only when a step lands.
+		m_IsDirty |= interpolate;
+	}
+
+	void Scene::RecordForces()
+	{
+		m_Forces.resize(m_Bodies.Size());
+		for (Simulation::BodyHandle body = 0; body < m_Bodies.Size(); ++body)
+		{
+			m_Forces[body] = m_Bodies.GetTotalForce(body);
+		}
+	}
+
+	const std::vector<Eigen::Vector3f>& Scene::GetRenderPositions() const
+	{
+		return m_RenderPositions;
+	}
+
+	const std::vector<Eigen::Quaternionf>& Scene::GetRenderRotations() const
+	{
+		return m_RenderRotations;
+	}
+
+	const Eigen::Vector3f& Scene::GetRenderPosition(Simulation::BodyHandle body) const
+	{
+		return m_RenderPositions[body];
+	}
+
+	const Eigen::Quaternionf& Scene::GetRenderRotation(Simulation::BodyHandle body) const
+	{
+		return m_RenderRotations[body];
+	}
+
+	const Eigen::Vector3f& Scene::GetRenderScale(Simulation::BodyHandle body) const
+	{
+		return m_Snapshots.GetCurrent().Scales[body];
+	}
+
+	bool Scene::HasRenderFlag(Simulation::BodyHandle body, Simulation::BodyFlags flag) const
+	{
+		return (m_Snapshots.GetCurrent().Flags[body] & flag) != 0;
 	}
 
 	void Scene::BeginScene()
 	{
+		// The viewport is created on first use so scenes can be constructed before the window exists.
+		if (!IsRenderTextureReady(m_ViewportTexture))
+		{
+			LoadViewportTexture();
+		}
+
 		BeginTextureMode(m_ViewportTexture);
 		ClearBackground(DARKGRAY);
 		BeginMode3D(m_SceneCamera);
@@ -159,24 +240,38 @@ namespace Engine
 		{
 			ImGui::DragFloat("Delta Time", &m_DeltaTime, 0.01f, 0.0f, 0.033f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
 		}
+
+		bool isDeterministic = IsDeterministic();
+		if (ImGui::Checkbox("Deterministic", &isDeterministic))
+		{
+			SetDeterministic(isDeterministic);
+		}
+		if (isDeterministic)
+		{
+			ImGui::DragFloat("Fixed Delta Time", &m_FixedDeltaTime, 0.001f, 0.001f, 0.033f, "%.4f", ImGuiSliderFlags_AlwaysClamp);
+		}
 		ImGui::EndDisabled();
 
+		if (IsDeterministic())
+		{
+			ImGui::Text("Step %llu, Hash %016llx", (unsigned long long)GetStepCount(), (unsigned long long)GetStateHash());
+		}
+
 		ImGui::DragInt("Substeps", &m_Substeps);
 		ImGui::DragInt("PositionIterations", &m_NumPosIterations);
-	}
 
-	void Scene::HandleXPBDLoop(const float deltaTime)
-	{
-		OnStartSimulationFrame();
+		const char* solverModes[] = { "Gauss-Seidel", "Jacobi" };
+		int solverMode = (int)m_SolverMode;
+		if (ImGui::Combo("Solver", &solverMode, solverModes, IM_ARRAYSIZE(solverModes)))
+		{
+			m_SolverMode = (Simulation::SolverMode)solverMode;
+		}
 
-		const float subStepTime = deltaTime / (float)m_Substeps;
-		for (int i = 0; i < m_Substeps; ++i)
+		if (m_SolverMode == Simulation::SolverMode::Jacobi)
 		{
-			OnUpdatePosition(subStepTime);
-			OnSolveConstraints(subStepTime);
-			OnPostSolveConstraints(subStepTime);
+			ImGui::DragFloat("Relaxation", &m_Relaxation, 0.05f, 0.1f, 2.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 		}
 
-		OnEndSimulationFrame();
+		ImGui::Text("Frame Arena Peak: %.1f KB", (float)GetFrameArenaPeakUsage() / 1024.0f);
 	}
 }
\ No newline at end of file
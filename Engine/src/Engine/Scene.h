@@ -1,17 +1,33 @@
 #pragma once
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "raylib.h"
 
+#include "Simulation/PhysicsScene.h"
+#include "Simulation/SnapshotBuffer.h"
+
 namespace Engine
 {
-    class Scene
+    /**
+    * Window, camera, drawing and editor of a scene. The bodies and solver calls come from
+    * the matching Simulation::SceneSimulation, which the concrete scenes derive from as well.
+    */
+    class Scene : public virtual Simulation::PhysicsScene
     {
     public:
         Scene(std::string sceneName);
         virtual ~Scene();
     
+        /**
+        * Resets the scene under its mutex, the simulation thread may still be finishing a step.
+        */
         void Init();
+        /**
+        * Samples the camera and the scene inputs, once per frame on the main thread.
+        * The simulation thread only reads what was sampled, while it holds the scene mutex.
+        */
         void ProcessEvents();
         
         /**
@@ -21,7 +37,7 @@ namespace Engine
         */
         virtual void Update(const float deltaTime);
 
-        void Simulate(const float deltaTime);
+        void Simulate(const float deltaTime) override;
         void HandleWindowResize();
 
         bool ShouldRender() const;
@@ -36,32 +52,54 @@ namespace Engine
         const std::string GetName() const;
         const RenderTexture& GetViewportTexture() const;
 
-        const int GetSubsteps() const;
-        const int GetNumPosIterations() const;
-
         const Camera& GetSceneCamera() const;
 
         void MarkDirty();
+
+        /**
+        * Held by the simulation thread while it steps, and by the main thread while it handles events,
+        * edits the scene or resets it. Drawing reads the snapshots only and does not take it.
+        */
+        std::mutex& GetMutex();
+
+        /**
+        * Copies the body transforms, the recorded forces and the contacts into the snapshot buffer, after every step.
+        */
+        void PublishSnapshot();
+
+        /**
+        * Picks up the newest snapshot and blends it with the one before. With interpolate set, the blend follows
+        * the time since the newest snapshot arrived, one fixed step behind the simulation. Otherwise the newest is used as is.
+        * Marks the scene dirty when a new snapshot arrived.
+        */
+        void UpdateRenderTransforms(const float deltaTime, const bool interpolate);
     protected:
         // Setup
         virtual void OnInit() = 0;
         virtual void OnShutdown() = 0;
         
         virtual void OnUpdate(const float deltaTime) = 0;
+        // Samples the keys of the scene inputs
+        virtual void OnProcessEvents() {}
 
-        // Updates
-        virtual void OnStartSimulationFrame() = 0;
-        virtual void OnUpdatePosition(const float substepTime) = 0;
-        virtual void OnSolveConstraints(const float substepTime) = 0;
-        virtual void OnPostSolveConstraints(const float substepTime) = 0;
-        virtual void OnEndSimulationFrame() = 0;
-
-        
         virtual void OnDraw() = 0;
         virtual void OnDrawEditor();
 
+        /**
+        * Keeps the net force of every body for the force markers. Call from OnEndSimulationFrame, before the forces are cleared.
+        */
+        void RecordForces();
+
+        // Render state from the snapshots. OnDraw reads only these, never the bodies the simulation thread steps.
+        const std::vector<Eigen::Vector3f>& GetRenderPositions() const;
+        const std::vector<Eigen::Quaternionf>& GetRenderRotations() const;
+        const Eigen::Vector3f& GetRenderPosition(Simulation::BodyHandle body) const;
+        const Eigen::Quaternionf& GetRenderRotation(Simulation::BodyHandle body) const;
+        const Eigen::Vector3f& GetRenderScale(Simulation::BodyHandle body) const;
+        bool HasRenderFlag(Simulation::BodyHandle body, Simulation::BodyFlags flag) const;
+
     private:
-        void HandleXPBDLoop(const float deltaTime);
+        void LoadViewportTexture();
 
     protected:
         bool m_IsDirty = false;
@@ -71,13 +109,13 @@ namespace Engine
         RenderTexture m_ViewportTexture;
         Camera m_SceneCamera;
 
-        bool m_OverrideDeltaTime = false;
-        float m_DeltaTime = 0.0f;
-        float m_Accumulator = 0.0f;
-
-        int m_Substeps = 8;
-        int m_NumPosIterations = 1;
-
         bool m_DrawGrid = false;
+
+        std::mutex m_Mutex;
+        Simulation::SnapshotBuffer m_Snapshots;
+        float m_SnapshotAge = 0.0f;
+        std::vector<Eigen::Vector3f> m_Forces;
+        std::vector<Eigen::Vector3f> m_RenderPositions;
+        std::vector<Eigen::Quaternionf> m_RenderRotations;
     };
 }
\ No newline at end of file
@@ -3,11 +3,14 @@
 #include "imgui.h"
 #include "rlImGui.h"
 
+#include "Simulation/JobSystem.h"
+
 namespace Engine
 {
 	void SimulationControls::AttachToScene(const std::shared_ptr<Scene> &scene)
 	{
 		m_CurrentScene = scene;
+		m_SimulationThread.SetScene(scene);
 	}
 
 	void SimulationControls::Update(const float deltaTime)
@@ -17,12 +20,32 @@ namespace Engine
 			return;
 		}
 
+		if (m_UseSimulationThread)
+		{
+			m_SimulationThread.Start();
+			m_SimulationThread.SetPlaying(m_UpdateMode == UpdateMode::PLAY);
+			if (m_UpdateMode == UpdateMode::STEP)
+			{
+				m_SimulationThread.RequestStep();
+			}
+		}
+		else if (m_UpdateMode > UpdateMode::PAUSED)
+		{
+			m_CurrentScene->Simulate(deltaTime);
+		}
+
 		if (m_UpdateMode > UpdateMode::PAUSED)
 		{
 			m_SimulationTime += deltaTime;
-			m_CurrentScene->Simulate(deltaTime);
 		}
 
+		// Edits made while nothing steps still have to reach the snapshots that get drawn.
+		if (!IsThreadStepping())
+		{
+			m_CurrentScene->PublishSnapshot();
+		}
+		m_CurrentScene->UpdateRenderTransforms(deltaTime, IsThreadStepping());
+
 		if (m_UpdateMode == UpdateMode::STEP)
 		{
 			m_UpdateMode = UpdateMode::PAUSED;
@@ -47,6 +70,7 @@ namespace Engine
 	void SimulationControls::Reset()
 	{
 		m_UpdateMode = UpdateMode::PAUSED;
+		m_SimulationThread.SetPlaying(false);
 		if (m_CurrentScene)
 		{
 			m_CurrentScene->Init();
@@ -77,6 +101,28 @@ namespace Engine
 			Step();
 		}
 
+		Simulation::JobSystem& jobSystem = Simulation::JobSystem::Get();
+		int numWorkers = (int)jobSystem.GetNumWorkers();
+		if (ImGui::SliderInt("Worker Threads", &numWorkers, 0, (int)Simulation::JobSystem::GetDefaultNumWorkers()))
+		{
+			// Not while the simulation thread is running jobs of a step.
+			std::unique_lock<std::mutex> sceneLock;
+			if (m_CurrentScene)
+			{
+				sceneLock = std::unique_lock<std::mutex>(m_CurrentScene->GetMutex());
+			}
+			jobSystem.SetNumWorkers((uint32_t)numWorkers);
+		}
+
+		if (ImGui::Checkbox("Simulation Thread", &m_UseSimulationThread) && !m_UseSimulationThread)
+		{
+			m_SimulationThread.SetPlaying(false);
+		}
+		if (m_UseSimulationThread && m_CurrentScene)
+		{
+			ImGui::Text("Steps/s: %.1f (target %.1f)", m_SimulationThread.GetStepsPerSecond(), 1.0f / m_CurrentScene->GetFixedDeltaTime());
+		}
+
 		ImGui::End();
 	}
 
@@ -90,4 +136,16 @@ namespace Engine
 		Pause();
 		Reset();
 	}
+
+	void SimulationControls::Shutdown()
+	{
+		m_SimulationThread.Stop();
+		m_SimulationThread.SetScene(nullptr);
+		m_CurrentScene = nullptr;
+	}
+
+	bool SimulationControls::IsThreadStepping() const
+	{
+		return m_UseSimulationThread && m_UpdateMode == UpdateMode::PLAY;
+	}
 }
\ No newline at end of file
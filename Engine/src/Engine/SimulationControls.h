@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 
+#include "SimulationThread.h"
+
 namespace Engine
 {
 	class Scene;
@@ -23,6 +25,7 @@ namespace Engine
 		bool CheckUpdateMode(UpdateMode mode) const;
 
 		void ForceStop();
+		void Shutdown();
 
 	private:
 		void Play();
@@ -30,10 +33,16 @@ namespace Engine
 		void Reset();
 		void Step();
 
+		bool IsThreadStepping() const;
+
 	private:
 		std::shared_ptr<Scene> m_CurrentScene;
 		UpdateMode m_UpdateMode;
 		float m_SimulationTime;
 		bool m_SimulationStarted = false;
+
+		SimulationThread m_SimulationThread;
+		// Off, the scene is simulated on the main thread with the frame time like before
+		bool m_UseSimulationThread = true;
 	};
 }
\ No newline at end of file
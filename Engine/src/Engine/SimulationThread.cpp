@@ -0,0 +1,160 @@
+#include "SimulationThread.h"
+#include "Scene.h"
+
+#include <chrono>
+
+namespace Engine
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// Further behind than this, the thread gives up on catching up and restarts its schedule.
+		constexpr std::chrono::milliseconds MAX_STEP_LAG(250);
+	}
+
+	SimulationThread::~SimulationThread()
+	{
+		Stop();
+	}
+
+	void SimulationThread::Start()
+	{
+		if (m_Thread.joinable())
+		{
+			return;
+		}
+
+		m_Quit = false;
+		m_Thread = std::thread(&SimulationThread::Loop, this);
+	}
+
+	void SimulationThread::Stop()
+	{
+		if (!m_Thread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Quit = true;
+		}
+		m_Wake.notify_all();
+		m_Thread.join();
+	}
+
+	bool SimulationThread::IsStarted() const
+	{
+		return m_Thread.joinable();
+	}
+
+	void SimulationThread::SetScene(const std::shared_ptr<Scene>& scene)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Scene = scene;
+		m_Playing = false;
+		m_PendingSteps = 0;
+	}
+
+	void SimulationThread::SetPlaying(const bool playing)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Playing == playing)
+			{
+				return;
+			}
+			m_Playing = playing;
+		}
+		m_Wake.notify_all();
+	}
+
+	void SimulationThread::RequestStep()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			++m_PendingSteps;
+		}
+		m_Wake.notify_all();
+	}
+
+	float SimulationThread::GetStepsPerSecond() const
+	{
+		return m_StepsPerSecond.load(std::memory_order_relaxed);
+	}
+
+	void SimulationThread::Loop()
+	{
+		Clock::time_point nextStep = Clock::now();
+		Clock::time_point rateStart = nextStep;
+		uint32_t rateSteps = 0;
+		bool wasPlaying = false;
+
+		while (true)
+		{
+			std::shared_ptr<Scene> scene;
+			bool isPlaying = false;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				if (!m_Playing || !m_Scene)
+				{
+					m_StepsPerSecond.store(0.0f, std::memory_order_relaxed);
+				}
+
+				m_Wake.wait(lock, [this]() { return m_Quit || (m_Scene && (m_Playing || m_PendingSteps > 0)); });
+				if (m_Quit)
+				{
+					return;
+				}
+
+				scene = m_Scene;
+				isPlaying = m_Playing;
+				if (!isPlaying)
+				{
+					--m_PendingSteps;
+				}
+			}
+
+			// The schedule and the rate restart whenever play resumes.
+			if (isPlaying && !wasPlaying)
+			{
+				nextStep = rateStart = Clock::now();
+				rateSteps = 0;
+			}
+			wasPlaying = isPlaying;
+
+			float fixedDeltaTime;
+			{
+				std::lock_guard<std::mutex> sceneLock(scene->GetMutex());
+				scene->Step();
+				scene->PublishSnapshot();
+				fixedDeltaTime = scene->GetFixedDeltaTime();
+			}
+
+			if (!isPlaying)
+			{
+				continue;
+			}
+
+			++rateSteps;
+			const Clock::time_point now = Clock::now();
+			if (now - rateStart >= std::chrono::seconds(1))
+			{
+				m_StepsPerSecond.store((float)rateSteps / std::chrono::duration<float>(now - rateStart).count(), std::memory_order_relaxed);
+				rateStart = now;
+				rateSteps = 0;
+			}
+
+			nextStep += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(fixedDeltaTime));
+			if (now - nextStep > MAX_STEP_LAG)
+			{
+				nextStep = now;
+			}
+
+			// Sleeps until the next step is due, waking early when paused or stopped.
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Wake.wait_until(lock, nextStep, [this]() { return m_Quit || !m_Playing; });
+		}
+	}
+}
\ No newline at end of file
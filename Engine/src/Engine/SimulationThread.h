@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Engine
+{
+	class Scene;
+
+	/**
+	* Steps the attached scene on its own thread at the scene's fixed delta time, independent of the frame rate.
+	* Every step runs with the scene mutex held and publishes a transform snapshot for the renderer.
+	*/
+	class SimulationThread
+	{
+	public:
+		SimulationThread() = default;
+		~SimulationThread();
+
+		void Start();
+		void Stop();
+		bool IsStarted() const;
+
+		void SetScene(const std::shared_ptr<Scene>& scene);
+
+		/**
+		* Playing steps continuously, otherwise the thread sleeps until RequestStep.
+		*/
+		void SetPlaying(const bool playing);
+		void RequestStep();
+
+		// Steps per second over the last second of play
+		float GetStepsPerSecond() const;
+
+	private:
+		void Loop();
+
+	private:
+		std::thread m_Thread;
+
+		// Guards the scene, the play state and the pending steps
+		std::mutex m_Mutex;
+		std::condition_variable m_Wake;
+		std::shared_ptr<Scene> m_Scene;
+		bool m_Playing = false;
+		bool m_Quit = false;
+		uint32_t m_PendingSteps = 0;
+
+		std::atomic<float> m_StepsPerSecond{ 0.0f };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "BoxStackScene.h"
+#include "Engine/Application.h"
+#include "raymath.h"
+#include "imgui.h"
+
+#include "Utils/EigenToRaylib.h"
+#include "Utils/PhysicsUtils.h"
+
+namespace Scenes
+{
+	namespace
+	{
+		static std::array<Utils::Physics::ForceInput, 2> ForceInputs;
+	}
+
+	BoxStackScene::BoxStackScene(const std::string& sceneName)
+		: Scene(sceneName)
+	{
+		SetupInputs();
+	}
+
+	BoxStackScene::~BoxStackScene()
+	{
+	}
+
+	void BoxStackScene::OnInit()
+	{
+		Reset();
+	}
+
+	void BoxStackScene::OnUpdate(const float substepTime)
+	{
+	}
+
+	void BoxStackScene::OnProcessEvents()
+	{
+		for (auto& forceInput : ForceInputs)
+		{
+			forceInput.ProcessEvents();
+		}
+	}
+
+	void BoxStackScene::OnStartSimulationFrame()
+	{
+		BoxStackSimulation::OnStartSimulationFrame();
+
+		for (auto& forceInput : ForceInputs)
+		{
+			forceInput.Apply(m_Bodies);
+		}
+	}
+
+	void BoxStackScene::OnShutdown()
+	{
+	}
+
+	void BoxStackScene::SetupInputs()
+	{
+		ForceInputs[0].Body = m_Entities[STACK_HEIGHT].Body;
+		ForceInputs[0].ActivationKey = KEY_L;
+		ForceInputs[0].ForcePosition = Eigen::Vector3f::Zero();
+		ForceInputs[0].ForceVector = Eigen::Vector3f(20.0f, 0.0f, 0.0f);
+		ForceInputs[0].IsRotationalForce = false;
+
+		ForceInputs[1].Body = m_Entities.back().Body;
+		ForceInputs[1].ActivationKey = KEY_K;
+		ForceInputs[1].ForcePosition = Eigen::Vector3f::Zero();
+		ForceInputs[1].ForceVector = Eigen::Vector3f(0.0f, 0.0f, 20.0f);
+		ForceInputs[1].IsRotationalForce = false;
+	}
+
+	void BoxStackScene::OnDraw()
+	{
+		using namespace Utils::Math;
+
+		Model cubeModel = Engine::Application::Get().GetResources().CubeModel;
+		for (size_t i = 0; i < m_Entities.size(); ++i)
+		{
+			const Simulation::BodyHandle body = m_Entities[i].Body;
+
+			Eigen::Affine3f transform;
+			transform = Eigen::Translation3f(GetRenderPosition(body)) * GetRenderRotation(body).toRotationMatrix() * Eigen::Scaling(GetRenderScale(body));
+			cubeModel.transform = ToMatrix(transform.matrix());
+
+			// The ground, then the column in alternating colors, then the pyramid
+			const Color color = i == 0 ? DARKGRAY : i <= STACK_HEIGHT ? (i % 2 == 1 ? ORANGE : BEIGE) : SKYBLUE;
+			const bool isSleeping = !HasRenderFlag(body, Simulation::BODY_FLAG_STATIC) && !HasRenderFlag(body, Simulation::BODY_FLAG_ACTIVE);
+			DrawModel(cubeModel, Vector3Zero(), 1.0f, isSleeping ? ColorBrightness(color, -0.5f) : color);
+		}
+
+		for (auto& forceInput : ForceInputs)
+		{
+			forceInput.Draw(GetRenderPositions(), GetRenderRotations());
+		}
+	}
+
+	void BoxStackScene::OnDrawEditor()
+	{
+		Scene::OnDrawEditor();
+
+		ImGui::DragFloat("Gravity", &m_Gravity, 0.1f);
+		if (ImGui::DragFloat("Linear Damping", &m_LinearDamping, 0.01f, 0.0f, 10.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp)
+			| ImGui::DragFloat("Angular Damping", &m_AngularDamping, 0.01f, 0.0f, 10.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp))
+		{
+			for (auto& entity : m_Entities)
+			{
+				m_Bodies.LinearDampings[entity.Body] = m_LinearDamping;
+				m_Bodies.AngularDampings[entity.Body] = m_AngularDamping;
+			}
+		}
+
+		ImGui::SeparatorText("Sleeping");
+		if (ImGui::Checkbox("Enable Sleeping", &m_EnableSleeping) && !m_EnableSleeping)
+		{
+			for (auto& entity : m_Entities)
+			{
+				m_Bodies.WakeUp(entity.Body);
+			}
+		}
+		ImGui::DragFloat("Linear Threshold", &m_SleepSettings.LinearThreshold, 0.001f, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat("Angular Threshold", &m_SleepSettings.AngularThreshold, 0.001f, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat("Time To Sleep", &m_SleepSettings.TimeToSleep, 0.01f, 0.0f, 10.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::Text("Islands: %d, Sleeping Bodies: %d", (int)m_Islands.GetNumIslands(), (int)m_Islands.GetNumSleepingBodies());
+
+		ImGui::SeparatorText("Islands");
+		ImGui::Checkbox("Island Parallel", &m_IslandParallel);
+		if (IsIslandParallel())
+		{
+			ImGui::Text("Awake Islands: %d, Batches: %d", (int)m_Schedule.Islands.size(), (int)m_Schedule.GetNumBatches());
+		}
+
+		ImGui::SeparatorText("Contacts");
+		ImGui::Text("Manifolds: %d, Points: %d", (int)m_Contacts.size(), (int)m_Constraints.GetPool<Simulation::ContactConstraint>().size());
+		ImGui::DragFloat("Static Friction", &m_Material.StaticFriction, 0.01f, 0.0f, 2.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat("Dynamic Friction", &m_Material.DynamicFriction, 0.01f, 0.0f, 2.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat("Restitution", &m_Material.Restitution, 0.01f, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat("Compliance", &m_Material.Compliance, 0.0001f, 0.0f, 1.0f, "%.4f", ImGuiSliderFlags_AlwaysClamp);
+
+		ImGui::SeparatorText("Force Input");
+		for (auto& forceInput : ForceInputs)
+		{
+			m_IsDirty |= forceInput.DrawSettings();
+		}
+	}
+}
\ No newline at end of file
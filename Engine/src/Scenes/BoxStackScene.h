@@ -0,0 +1,38 @@
+#pragma once
+#include "Engine/Scene.h"
+#include "Scenes/BoxStackSimulation.h"
+
+namespace Scenes
+{
+	/**
+	* A column and a pyramid of boxes resting on a static ground box, held up only by contacts.
+	*/
+	class BoxStackScene final : public Engine::Scene, public Simulation::BoxStackSimulation
+	{
+	public:
+		BoxStackScene(const std::string &sceneName);
+		virtual ~BoxStackScene();
+
+	protected:
+		void OnInit() override;
+
+		void OnUpdate(const float substepTime) override;
+
+		void OnProcessEvents() override;
+
+		void OnStartSimulationFrame() override;
+
+		void OnDraw() override;
+
+		void OnDrawEditor() override;
+
+		void OnShutdown() override;
+
+	private:
+		void SetupInputs();
+
+	private:
+		float m_LinearDamping = 0.0f;
+		float m_AngularDamping = 0.0f;
+	};
+}
@@ -1,10 +1,10 @@
 #pragma once 
 #include "Engine/Scene.h"
-#include "Engine/Entity.h"
+#include "Scenes/CubeHingeSimulation.h"
 
 namespace Scenes
 {
-	class CubeHingeScene final: public Engine::Scene
+	class CubeHingeScene final: public Engine::Scene, public Simulation::CubeHingeSimulation
 	{
 	public:
 		CubeHingeScene(const std::string& sceneName);
@@ -15,13 +15,9 @@ namespace Scenes
 
 		void OnUpdate(const float substepTime) override;
 
-		void OnStartSimulationFrame() override;
-
-		void OnUpdatePosition(const float substepTime) override;
+		void OnProcessEvents() override;
 
-		void OnSolveConstraints(const float substepTime) override;
-
-		void OnPostSolveConstraints(const float substepTime) override;
+		void OnStartSimulationFrame() override;
 
 		void OnEndSimulationFrame() override;
 
@@ -32,8 +28,6 @@ namespace Scenes
 		void OnShutdown() override;
 
 	private:
-		void SetupEntities();
-		void SetupConstraints();
 		void SetupInputs();
 	};
 }
\ No newline at end of file
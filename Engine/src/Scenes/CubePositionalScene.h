@@ -1,10 +1,10 @@
 #pragma once 
 #include "Engine/Scene.h"
-#include "Engine/Entity.h"
+#include "Scenes/CubePositionalSimulation.h"
 
 namespace Scenes
 {
-	class CubePositionalScene final: public Engine::Scene
+	class CubePositionalScene final: public Engine::Scene, public Simulation::CubePositionalSimulation
 	{
 	public:
 		CubePositionalScene(const std::string& sceneName);
@@ -15,13 +15,9 @@ namespace Scenes
 
 		void OnUpdate(const float substepTime) override;
 
-		void OnStartSimulationFrame() override;
-
-		void OnUpdatePosition(const float substepTime) override;
-
-		void OnSolveConstraints(const float substepTime) override;
+		void OnProcessEvents() override;
 
-		void OnPostSolveConstraints(const float substepTime) override;
+		void OnStartSimulationFrame() override;
 
 		void OnEndSimulationFrame() override;
 
@@ -32,12 +28,6 @@ namespace Scenes
 		void OnShutdown() override;
 
 	private:
-		void SetupEntites();
-		void SetupConstraints();
 		void SetupInputs();
-
-	private:
-		float m_Gravity = -9.8f;
-		bool m_EnableGravity = true;
 	};
-}
\ No newline at end of file
+}
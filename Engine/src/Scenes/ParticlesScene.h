@@ -1,6 +1,6 @@
 #pragma once
 #include "Engine/Scene.h"
-#include "Engine/Entity.h"
+#include "Scenes/ParticlesSimulation.h"
 
 #include <vector>
 #include <string>
@@ -9,7 +9,7 @@
 
 namespace Scenes
 {
-	class ParticlesScene final : public Engine::Scene
+	class ParticlesScene final : public Engine::Scene, public Simulation::ParticlesSimulation
 	{
 	public:
 		ParticlesScene(const std::string &sceneName);
@@ -19,13 +19,9 @@ namespace Scenes
 
 		void OnUpdate(const float substepTime) override;
 
-		void OnStartSimulationFrame() override;
-
-		void OnUpdatePosition(const float substepTime) override;
-
-		void OnSolveConstraints(const float substepTime) override;
+		void OnProcessEvents() override;
 
-		void OnPostSolveConstraints(const float substepTime) override;
+		void OnStartSimulationFrame() override;
 
 		void OnEndSimulationFrame() override;
 
@@ -36,16 +32,8 @@ namespace Scenes
 		void OnShutdown() override;
 
 	private:
-		void SetupEntities();
-		void SetupConstraints();
 		void SetupInputs();
 
-		void DrawParticle(const std::string &particleName, Simulation::Entity &particle, size_t StoredForceIndex);
-
-	private:
-		float m_ParticleDrawRadius = 0.1f;
-		float m_Gravity = -9.8f;
-		bool m_EnableGravity = true;
-		bool m_GroundCollisions = true;
+		void DrawParticle(const std::string &particleName, Simulation::Entity &particle);
 	};
-}
\ No newline at end of file
+}
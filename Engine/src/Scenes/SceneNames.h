@@ -9,4 +9,5 @@ namespace Scenes
     DEFINE_SCENE(CubeRotationalScene);
     DEFINE_SCENE(CubeHingeScene);
     DEFINE_SCENE(DoorScene);
+    DEFINE_SCENE(BoxStackScene);
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "PhysicsUtils.h"
 #include "Engine/DebugDrawing.h"
-#include "Engine/Entity.h"
 
 #include "Utils/EigenToRaylib.h"
 #include "imgui.h"
@@ -35,33 +34,31 @@ namespace Utils::Physics
 		}
 	}
 
-	void ForceInput::Apply()
+	void ForceInput::Apply(Simulation::BodyStore& bodies)
 	{
-		ProcessEvents();
-		if (!Entity || !IsActive)
+		if (Body == Simulation::INVALID_BODY_HANDLE || !IsActive)
 		{
 			return;
 		}
 
-		Engine::DebugDrawing::DrawForceMarker(YELLOW, Entity->Position, Entity->Rotation, ForcePosition, ForceVector, IsLocal, -1.0f, 0.0f);
 		Simulation::PhysicalForce result = Simulation::PhysicalForce{ ForcePosition,ForceVector,IsLocal };
-		Entity->AddForce(result);
+		bodies.AddForce(Body, result);
+		bodies.WakeUp(Body);
 
 		if (IsRotationalForce)
 		{
 			Eigen::Vector3f reflectedPoint = -ForcePosition;
 			Eigen::Vector3f forceVector = -ForceVector;
 			Simulation::PhysicalForce result2{ reflectedPoint, forceVector, IsLocal };
-			Entity->AddForce(result2);
-			Engine::DebugDrawing::DrawForceMarker(ORANGE, Entity->Position, Entity->Rotation, reflectedPoint, forceVector, IsLocal, -1.0f, 0.0f);
+			bodies.AddForce(Body, result2);
 		}
 	}
 
-	void ForceInput::Draw()
+	void ForceInput::Draw(const std::vector<Eigen::Vector3f>& positions, const std::vector<Eigen::Quaternionf>& rotations)
 	{
 		using namespace Utils::Math;
 
-		if (!Entity)
+		if (Body == Simulation::INVALID_BODY_HANDLE)
 		{
 			return;
 		}
@@ -71,12 +68,24 @@ namespace Utils::Physics
 			return;
 		}
 
+		const Eigen::Vector3f& position = positions[Body];
+		const Eigen::Quaternionf& rotation = rotations[Body];
+
+		if (IsActive)
+		{
+			Engine::DebugDrawing::DrawForceMarker(YELLOW, position, rotation, ForcePosition, ForceVector, IsLocal, -1.0f, 0.0f);
+			if (IsRotationalForce)
+			{
+				Engine::DebugDrawing::DrawForceMarker(ORANGE, position, rotation, -ForcePosition, -ForceVector, IsLocal, -1.0f, 0.0f);
+			}
+		}
+
 		Eigen::Vector3f forcePosition = ForcePosition;
 		Eigen::Vector3f forceVector = ForceVector;
 		if (IsLocal)
 		{
-			forcePosition = Entity->Position + Entity->Rotation.toRotationMatrix() * ForcePosition;
-			forceVector = Entity->Rotation.toRotationMatrix() * ForceVector;
+			forcePosition = position + rotation.toRotationMatrix() * ForcePosition;
+			forceVector = rotation.toRotationMatrix() * ForceVector;
 		}
 
 		DrawCylinderEx(ToVector3(forcePosition - MarkerScale * forceVector.normalized()), ToVector3(forcePosition), 0.5f * MarkerScale, 0.0f, 8, GOLD);
@@ -87,8 +96,8 @@ namespace Utils::Physics
 			Eigen::Vector3f forceVector2 = -ForceVector;
 			if (IsLocal)
 			{
-				forcePosition = Entity->Position + Entity->Rotation.toRotationMatrix() * forcePosition2;
-				forceVector = Entity->Rotation.toRotationMatrix() * forceVector2;
+				forcePosition = position + rotation.toRotationMatrix() * forcePosition2;
+				forceVector = rotation.toRotationMatrix() * forceVector2;
 			}
 
 			DrawCylinderEx(ToVector3(forcePosition - MarkerScale * forceVector.normalized()), ToVector3(forcePosition), 0.5f * MarkerScale, 0.0f, 8, ORANGE);
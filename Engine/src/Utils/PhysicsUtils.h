@@ -1,12 +1,8 @@
 #pragma once
 #include "raylib.h"
 #include <Eigen/Dense>
-#include "Engine/Entity.h"
-
-namespace Simulation
-{
-    struct Entity;
-}
+#include <vector>
+#include "Simulation/BodyStore.h"
 
 
 namespace Utils::Physics
@@ -23,17 +19,19 @@ namespace Utils::Physics
         KeyboardKey ActivationKey = KEY_NULL;
         Eigen::Vector3f ForceVector;
         Eigen::Vector3f ForcePosition;
-        Simulation::Entity* Entity = nullptr;
+        Simulation::BodyHandle Body = Simulation::INVALID_BODY_HANDLE;
         float MarkerScale = 0.2f;
         bool IsActive = false;
         bool SkipProcessInputsNextFrame = false;
         bool IsLocal = false;
         bool IsRotationalForce = false;
 
+        // Samples the activation key, on the main thread once per frame
         void ProcessEvents();
-        void Apply();
+        // Adds the force while active, on the simulation thread. Reads IsActive as last sampled.
+        void Apply(Simulation::BodyStore& bodies);
 
-        void Draw();
+        void Draw(const std::vector<Eigen::Vector3f>& positions, const std::vector<Eigen::Quaternionf>& rotations);
         bool DrawSettings();
     };
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+project "XPBDBench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+    staticruntime "on"
+
+    targetdir(targetPath)
+    objdir(objectPath)
+    location(projectLocation)
+
+    dependson {
+       "XPBDCore"
+    }
+
+    links{
+       "XPBDCore"
+    }
+
+    files { 
+        "src/**.h",
+        "src/**.cpp",
+    }
+
+    includedirs {
+        "src",
+        "%{IncludeDirs.XPBDCore}",
+        "%{IncludeDirs.eigen}",
+        "%{IncludeDirs.eigen}/Eigen/",
+    }
+
+    filter "options:avx2"
+        vectorextensions "AVX2"
+
+    filter "options:strictfp"
+        floatingpoint "Strict"
+        defines { "XPBD_STRICT_FP" }
+
+    filter { "options:strictfp", "toolset:gcc or clang" }
+        buildoptions { "-ffp-contract=off" }
+
+    filter "configurations:Debug"
+        defines { "BUILD_DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "BUILD_RELEASE" }
+        optimize "On"
\ No newline at end of file
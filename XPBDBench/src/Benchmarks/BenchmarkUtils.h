@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+	struct BenchmarkOptions
+	{
+		uint32_t Threads = 0;
+		uint32_t Iterations = 100;
+		uint32_t Size = 128;
+
+		// Scene stepping
+		uint32_t Frames = 600;
+		int Substeps = 8;
+		int PosIterations = 1;
+		// Worker counts the scenes are stepped with, one run each. Empty runs with Threads only.
+		std::vector<uint32_t> ThreadCounts;
+		// Empty steps every scene
+		std::string Scene;
+		bool Json = false;
+	};
+
+	class Timer
+	{
+	public:
+		Timer() : m_Start(std::chrono::steady_clock::now()) {}
+
+		double ElapsedMilliseconds() const
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+
+	private:
+		std::chrono::steady_clock::time_point m_Start;
+	};
+
+	/**
+	* Small deterministic generator so every run builds the same data set.
+	*/
+	class Random
+	{
+	public:
+		explicit Random(uint32_t seed) : m_State(seed ? seed : 1u) {}
+
+		uint32_t Next()
+		{
+			m_State ^= m_State << 13;
+			m_State ^= m_State >> 17;
+			m_State ^= m_State << 5;
+			return m_State;
+		}
+
+		float Range(const float min, const float max)
+		{
+			return min + (max - min) * (float)(Next() & 0xFFFFFF) / (float)0xFFFFFF;
+		}
+
+	private:
+		uint32_t m_State;
+	};
+}
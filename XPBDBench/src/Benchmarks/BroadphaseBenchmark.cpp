@@ -0,0 +1,137 @@
+#include "BroadphaseBenchmark.h"
+
+#include "Collision/DynamicAabbTree.h"
+#include "Collision/LinearBvh.h"
+#include "Simulation/BodyStore.h"
+#include "Simulation/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+namespace Bench
+{
+	namespace
+	{
+		constexpr float SUBSTEP_TIME = 1.0f / 480.0f;
+		constexpr float TREE_MARGIN = 0.05f;
+
+		void BuildBoxes(const uint32_t numBoxes, Simulation::BodyStore& bodies)
+		{
+			using namespace Simulation;
+			Random random(2468);
+
+			// Unit boxes at roughly the density of a pile, so every box has a few neighbours.
+			const float side = 1.2f * std::cbrt((float)numBoxes);
+			for (uint32_t i = 0; i < numBoxes; ++i)
+			{
+				BodyDesc desc;
+				desc.BodyCollider.Type = ColliderType::Box;
+
+				const BodyHandle body = bodies.Add(desc);
+				bodies.Positions[body] = Eigen::Vector3f(random.Range(0.0f, side), random.Range(0.0f, side), random.Range(0.0f, side));
+				const Eigen::Vector3f axis = Eigen::Vector3f(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f)).normalized();
+				bodies.Rotations[body] = Eigen::Quaternionf(Eigen::AngleAxisf(random.Range(-3.0f, 3.0f), axis));
+				bodies.LinearVelocities[body] = Eigen::Vector3f(random.Range(-5.0f, 5.0f), random.Range(-5.0f, 5.0f), random.Range(-5.0f, 5.0f));
+			}
+		}
+
+		void MoveBoxes(Simulation::BodyStore& bodies)
+		{
+			using namespace Simulation;
+			ParallelFor(0, (uint32_t)bodies.Size(), [&](const uint32_t body)
+			{
+				bodies.Positions[body] += SUBSTEP_TIME * bodies.LinearVelocities[body];
+			}, 1024);
+		}
+
+		size_t CountMissingPairs(std::vector<Simulation::BodyPair> expected, std::vector<Simulation::BodyPair> found)
+		{
+			using namespace Simulation;
+			auto less = [](const BodyPair& a, const BodyPair& b)
+			{
+				return a.Body1 != b.Body1 ? a.Body1 < b.Body1 : a.Body2 < b.Body2;
+			};
+			std::sort(expected.begin(), expected.end(), less);
+			std::sort(found.begin(), found.end(), less);
+
+			std::vector<BodyPair> missing;
+			std::set_difference(expected.begin(), expected.end(), found.begin(), found.end(), std::back_inserter(missing), less);
+			return missing.size();
+		}
+	}
+
+	bool RunBroadphaseBenchmark(const BenchmarkOptions& options)
+	{
+		using namespace Simulation;
+
+		BodyStore initialBodies;
+		BuildBoxes(options.Size * options.Size, initialBodies);
+		initialBodies.UpdateTransformCache();
+
+		// Linear BVH, rebuilt from scratch after every move
+		BodyStore bvhBodies = initialBodies;
+		LinearBvh bvh;
+
+		Timer bvhFirstTimer;
+		bvh.Build(bvhBodies);
+		const double bvhFirstTime = bvhFirstTimer.ElapsedMilliseconds();
+
+		double bvhTime = 0.0;
+		double bvhPairTime = 0.0;
+		std::vector<BodyPair> bvhPairs;
+		for (uint32_t i = 0; i < options.Iterations; ++i)
+		{
+			MoveBoxes(bvhBodies);
+
+			Timer buildTimer;
+			bvh.Build(bvhBodies);
+			bvhTime += buildTimer.ElapsedMilliseconds();
+
+			Timer pairTimer;
+			bvh.FindPairs(bvhBodies, bvhPairs);
+			bvhPairTime += pairTimer.ElapsedMilliseconds();
+		}
+
+		// Incremental tree, every body moves so every leaf outside its fat box is reinserted
+		BodyStore treeBodies = initialBodies;
+		DynamicAabbTree tree(TREE_MARGIN);
+
+		Timer treeFirstTimer;
+		tree.UpdateBodies(treeBodies);
+		const double treeFirstTime = treeFirstTimer.ElapsedMilliseconds();
+		tree.UpdatePairs(treeBodies);
+
+		double treeTime = 0.0;
+		double treePairTime = 0.0;
+		for (uint32_t i = 0; i < options.Iterations; ++i)
+		{
+			MoveBoxes(treeBodies);
+
+			Timer updateTimer;
+			tree.UpdateBodies(treeBodies);
+			treeTime += updateTimer.ElapsedMilliseconds();
+
+			Timer pairTimer;
+			tree.UpdatePairs(treeBodies);
+			treePairTime += pairTimer.ElapsedMilliseconds();
+		}
+
+		// The tree reports pairs of fat boxes, so it must find every pair of the tight BVH boxes.
+		const size_t missingPairs = CountMissingPairs(bvhPairs, tree.GetPairs());
+
+		const double iterations = (double)std::max(options.Iterations, 1u);
+		printf("Broadphase: %zu boxes, %u iterations, %u threads\n",
+			initialBodies.Size(), options.Iterations, JobSystem::Get().GetNumWorkers() + 1);
+		printf("  linear bvh   : first build %8.3f ms, rebuild %8.3f ms, pairs %8.3f ms\n",
+			bvhFirstTime, bvhTime / iterations, bvhPairTime / iterations);
+		printf("  dynamic tree : first build %8.3f ms, update  %8.3f ms, pairs %8.3f ms (height %d)\n",
+			treeFirstTime, treeTime / iterations, treePairTime / iterations, tree.GetHeight());
+		printf("  pairs: %zu bvh, %zu tree, %zu bvh pairs missing from the tree (expected 0)\n",
+			bvhPairs.size(), tree.GetPairs().size(), missingPairs);
+
+		return missingPairs == 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "Benchmarks/BenchmarkUtils.h"
+
+namespace Bench
+{
+	/**
+	* Moves Size * Size boxes every iteration and refreshes the broadphase with a full LinearBvh rebuild
+	* and with the incremental DynamicAabbTree. Reports the time per update and checks the pairs agree, failing when they do not.
+	*/
+	bool RunBroadphaseBenchmark(const BenchmarkOptions& options);
+}
\ No newline at end of file
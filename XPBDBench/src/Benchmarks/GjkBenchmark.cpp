@@ -0,0 +1,107 @@
+#include "GjkBenchmark.h"
+
+#include "Collision/Gjk.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Bench
+{
+	namespace
+	{
+		struct ShapePair
+		{
+			Simulation::OrientedBox Box;
+			Simulation::SphereShape Sphere;
+			Eigen::Vector3f SphereVelocity;
+			Eigen::Vector3f BoxAngularVelocity;
+		};
+
+		std::vector<ShapePair> BuildPairs(const uint32_t numPairs)
+		{
+			using namespace Simulation;
+			Random random(1357);
+
+			std::vector<ShapePair> pairs(numPairs);
+			for (ShapePair& pair : pairs)
+			{
+				pair.Box.HalfExtents = Eigen::Vector3f(random.Range(0.2f, 1.0f), random.Range(0.2f, 1.0f), random.Range(0.2f, 1.0f));
+				const Eigen::Vector3f axis = Eigen::Vector3f(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f)).normalized();
+				pair.Box.Axes = Eigen::AngleAxisf(random.Range(-3.0f, 3.0f), axis).toRotationMatrix();
+
+				pair.Sphere.Radius = random.Range(0.1f, 0.5f);
+				pair.Sphere.Center = Eigen::Vector3f(random.Range(-2.0f, 2.0f), random.Range(-2.0f, 2.0f), random.Range(-2.0f, 2.0f));
+				pair.SphereVelocity = Eigen::Vector3f(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f));
+				pair.BoxAngularVelocity = Eigen::Vector3f(random.Range(-2.0f, 2.0f), random.Range(-2.0f, 2.0f), random.Range(-2.0f, 2.0f));
+			}
+			return pairs;
+		}
+
+		void StepPairs(std::vector<ShapePair>& pairs, const float dt)
+		{
+			for (ShapePair& pair : pairs)
+			{
+				pair.Sphere.Center += dt * pair.SphereVelocity;
+				// Bounce inside a small volume so the pairs keep alternating between touching and separated
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (std::abs(pair.Sphere.Center(axis)) > 2.0f)
+					{
+						pair.SphereVelocity(axis) = -pair.SphereVelocity(axis);
+					}
+				}
+
+				const Eigen::Vector3f rotation = dt * pair.BoxAngularVelocity;
+				pair.Box.Axes = Eigen::AngleAxisf(rotation.norm(), rotation.normalized()).toRotationMatrix() * pair.Box.Axes;
+			}
+		}
+
+		void Run(std::vector<ShapePair> pairs, const uint32_t frames, const bool warmStart, double& milliseconds, double& averageIterations, size_t& contacts)
+		{
+			using namespace Simulation;
+			std::vector<GjkCache> caches(pairs.size());
+
+			uint64_t iterations = 0;
+			milliseconds = 0.0;
+			contacts = 0;
+			for (uint32_t frame = 0; frame < frames; ++frame)
+			{
+				StepPairs(pairs, 1.0f / 60.0f);
+
+				Timer timer;
+				for (size_t i = 0; i < pairs.size(); ++i)
+				{
+					const GjkResult result = GjkDistance(pairs[i].Box, pairs[i].Sphere, warmStart ? &caches[i] : nullptr);
+					iterations += result.Iterations;
+					contacts += (result.Intersecting || result.Distance < pairs[i].Sphere.Radius) ? 1 : 0;
+				}
+				milliseconds += timer.ElapsedMilliseconds();
+			}
+
+			averageIterations = (double)iterations / ((double)pairs.size() * frames);
+		}
+	}
+
+	bool RunGjkBenchmark(const BenchmarkOptions& options)
+	{
+		const std::vector<ShapePair> pairs = BuildPairs(options.Size * options.Size);
+
+		double coldTime = 0.0;
+		double coldIterations = 0.0;
+		size_t coldContacts = 0;
+		Run(pairs, options.Iterations, false, coldTime, coldIterations, coldContacts);
+
+		double warmTime = 0.0;
+		double warmIterations = 0.0;
+		size_t warmContacts = 0;
+		Run(pairs, options.Iterations, true, warmTime, warmIterations, warmContacts);
+
+		printf("GJK box-sphere: %zu pairs, %u frames\n", pairs.size(), options.Iterations);
+		printf("  cold : %9.3f ms, %.2f iterations/query\n", coldTime, coldIterations);
+		printf("  warm : %9.3f ms, %.2f iterations/query, %.2fx\n", warmTime, warmIterations, coldTime / warmTime);
+		printf("  contacts: %zu cold, %zu warm\n", coldContacts, warmContacts);
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "Benchmarks/BenchmarkUtils.h"
+
+namespace Bench
+{
+	/**
+	* Runs GJK over Size * Size box and sphere pairs that move a little every frame, once from scratch
+	* and once warm started from the cached simplex. Reports the time and the average number of iterations.
+	*/
+	bool RunGjkBenchmark(const BenchmarkOptions& options);
+}
\ No newline at end of file
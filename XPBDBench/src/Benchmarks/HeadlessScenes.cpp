@@ -0,0 +1,61 @@
+#include "HeadlessScenes.h"
+
+#include "Scenes/BoxStackSimulation.h"
+#include "Scenes/CubeHingeSimulation.h"
+#include "Scenes/CubePositionalSimulation.h"
+#include "Scenes/CubeRotationalSimulation.h"
+#include "Scenes/DoorSimulation.h"
+#include "Scenes/ParticlesSimulation.h"
+
+namespace Bench
+{
+	namespace
+	{
+		template<typename TSimulation>
+		std::unique_ptr<Simulation::SceneSimulation> Create()
+		{
+			return std::make_unique<TSimulation>();
+		}
+
+		struct SceneEntry
+		{
+			const char* Name;
+			std::unique_ptr<Simulation::SceneSimulation> (*Create)();
+		};
+
+		const SceneEntry Scenes[] = {
+			{ "ParticlesScene", Create<Simulation::ParticlesSimulation> },
+			{ "CubePositionalScene", Create<Simulation::CubePositionalSimulation> },
+			{ "CubeRotationalScene", Create<Simulation::CubeRotationalSimulation> },
+			{ "CubeHingeScene", Create<Simulation::CubeHingeSimulation> },
+			{ "DoorScene", Create<Simulation::DoorSimulation> },
+			{ "BoxStackScene", Create<Simulation::BoxStackSimulation> },
+		};
+	}
+
+	const std::vector<std::string>& GetHeadlessSceneNames()
+	{
+		static const std::vector<std::string> names = []()
+		{
+			std::vector<std::string> sceneNames;
+			for (const SceneEntry& scene : Scenes)
+			{
+				sceneNames.push_back(scene.Name);
+			}
+			return sceneNames;
+		}();
+		return names;
+	}
+
+	std::unique_ptr<Simulation::SceneSimulation> CreateHeadlessScene(const std::string& sceneName)
+	{
+		for (const SceneEntry& scene : Scenes)
+		{
+			if (sceneName == scene.Name)
+			{
+				return scene.Create();
+			}
+		}
+		return nullptr;
+	}
+}
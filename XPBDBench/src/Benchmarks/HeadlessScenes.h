@@ -0,0 +1,20 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+	/**
+	* Names of the Engine scenes, in the order of the scene menu.
+	*/
+	const std::vector<std::string>& GetHeadlessSceneNames();
+
+	/**
+	* Builds the simulation behind the named Engine scene in its reset state, without drawing, editor or keyboard forces.
+	* Returns null for an unknown name.
+	*/
+	std::unique_ptr<Simulation::SceneSimulation> CreateHeadlessScene(const std::string& sceneName);
+}
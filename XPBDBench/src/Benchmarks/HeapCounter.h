@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+
+namespace Bench
+{
+	/**
+	* Number of calls to the global operator new since the process started, from every thread.
+	* XPBDBench replaces the global allocation functions to count them, so the scene benchmark
+	* can check that stepping a warmed up scene stays off the heap.
+	*/
+	uint64_t GetNumHeapAllocations();
+}
@@ -0,0 +1,152 @@
+#include "PositionalKernelBenchmark.h"
+
+#include "Constraints/PositionalConstraint.h"
+#include "Constraints/PositionalConstraintBatch.h"
+#include "Constraints/TransformationData.h"
+#include "Simulation/BodyStore.h"
+#include "Simulation/ConstraintColoring.h"
+#include "Simulation/Simd.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace Bench
+{
+	namespace
+	{
+		constexpr float SUBSTEP_TIME = 1.0f / 480.0f;
+		constexpr float SPACING = 0.1f;
+		// The batched kernel reorders the float math, so positions drift apart by a few ulps per iteration.
+		// About 8e-5 on the default 64x64 grid, a wrong kernel is off by far more than 1% of the spacing.
+		constexpr float MAX_POSITION_DIFFERENCE = 0.01f * SPACING;
+
+		void BuildCloth(const uint32_t size, Simulation::BodyStore& bodies, std::vector<Simulation::PositionalConstraint>& constraints)
+		{
+			using namespace Simulation;
+			Random random(1234);
+
+			for (uint32_t y = 0; y < size; ++y)
+			{
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					BodyDesc desc;
+					desc.InverseMass = random.Range(0.5f, 2.0f);
+					desc.InertiaTensor = Eigen::Matrix3f::Identity() * random.Range(0.01f, 0.1f);
+					desc.IsStaticBody = (y == 0);
+
+					const BodyHandle body = bodies.Add(desc);
+					bodies.Positions[body] = Eigen::Vector3f(x * SPACING, -(float)y * SPACING, 0.0f)
+						+ Eigen::Vector3f(random.Range(-0.02f, 0.02f), random.Range(-0.02f, 0.02f), random.Range(-0.02f, 0.02f));
+					bodies.Rotations[body] = Eigen::Quaternionf(Eigen::AngleAxisf(random.Range(-0.3f, 0.3f), Eigen::Vector3f::UnitY()));
+				}
+			}
+
+			auto connect = [&](const BodyHandle body1, const BodyHandle body2, const Eigen::Vector3f& rest)
+			{
+				PositionalConstraint constraint;
+				constraint.Body1 = body1;
+				constraint.Body2 = body2;
+				constraint.LocalR1 = Eigen::Vector3f(0.5f * SPACING * 0.2f, 0.0f, 0.0f);
+				constraint.LocalR2 = Eigen::Vector3f(-0.5f * SPACING * 0.2f, 0.0f, 0.0f);
+				constraint.TargetDistance = rest;
+				constraint.Compliance = random.Range(0.0f, 1e-6f);
+				constraints.push_back(constraint);
+			};
+
+			for (uint32_t y = 0; y < size; ++y)
+			{
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					const BodyHandle body = y * size + x;
+					if (x + 1 < size)
+					{
+						connect(body, body + 1, Eigen::Vector3f(-SPACING, 0.0f, 0.0f));
+					}
+					if (y + 1 < size)
+					{
+						connect(body, body + size, Eigen::Vector3f(0.0f, SPACING, 0.0f));
+					}
+				}
+			}
+		}
+
+		double SolveScalar(Simulation::BodyStore& bodies, std::vector<Simulation::PositionalConstraint>& constraints,
+			const Simulation::ConstraintColoring& coloring, const uint32_t iterations)
+		{
+			using namespace Simulation;
+			std::vector<TransformationData> transformationData(constraints.size());
+
+			Timer timer;
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				SolveColored(coloring, [&](const uint32_t j)
+				{
+					if (i == 0)
+					{
+						constraints[j].Init();
+						transformationData[j] = GetTransformationData(bodies, constraints[j].Body1, constraints[j].Body2);
+					}
+					ComputePositionalData(transformationData[j], constraints[j].LocalR1, constraints[j].LocalR2);
+					constraints[j].Solve(transformationData[j], SUBSTEP_TIME);
+				});
+			}
+			return timer.ElapsedMilliseconds();
+		}
+
+		double SolveBatched(Simulation::BodyStore& bodies, std::vector<Simulation::PositionalConstraint>& constraints,
+			const Simulation::ConstraintColoring& coloring, const uint32_t iterations)
+		{
+			using namespace Simulation;
+			PositionalConstraintBatch batch;
+			batch.Build(constraints, coloring);
+
+			Timer timer;
+			batch.Init();
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				batch.Solve(bodies, SUBSTEP_TIME);
+			}
+			const double elapsed = timer.ElapsedMilliseconds();
+
+			batch.StoreLambdas(constraints);
+			return elapsed;
+		}
+	}
+
+	bool RunPositionalKernelBenchmark(const BenchmarkOptions& options)
+	{
+		using namespace Simulation;
+
+		BodyStore initialBodies;
+		std::vector<PositionalConstraint> initialConstraints;
+		BuildCloth(options.Size, initialBodies, initialConstraints);
+		initialBodies.UpdateTransformCache();
+
+		ConstraintColoring coloring;
+		coloring.Build(initialBodies, initialConstraints);
+
+		BodyStore scalarBodies = initialBodies;
+		std::vector<PositionalConstraint> scalarConstraints = initialConstraints;
+		const double scalarTime = SolveScalar(scalarBodies, scalarConstraints, coloring, options.Iterations);
+
+		BodyStore batchedBodies = initialBodies;
+		std::vector<PositionalConstraint> batchedConstraints = initialConstraints;
+		const double batchedTime = SolveBatched(batchedBodies, batchedConstraints, coloring, options.Iterations);
+
+		float maxPositionError = 0.0f;
+		for (BodyHandle body = 0; body < scalarBodies.Size(); ++body)
+		{
+			maxPositionError = std::max(maxPositionError, (scalarBodies.Positions[body] - batchedBodies.Positions[body]).cwiseAbs().maxCoeff());
+		}
+
+		const double solves = (double)initialConstraints.size() * options.Iterations;
+		printf("PositionalConstraint kernel: %zu constraints, %zu colors, %u iterations, %u lanes\n",
+			initialConstraints.size(), coloring.GetNumColors(), options.Iterations, Simd::LANE_WIDTH);
+		printf("  scalar  : %9.3f ms (%.2f ns/constraint)\n", scalarTime, scalarTime * 1e6 / solves);
+		printf("  batched : %9.3f ms (%.2f ns/constraint), %.2fx\n", batchedTime, batchedTime * 1e6 / solves, scalarTime / batchedTime);
+		printf("  max position difference: %g (tolerance %g)\n", maxPositionError, MAX_POSITION_DIFFERENCE);
+
+		return maxPositionError <= MAX_POSITION_DIFFERENCE;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "Benchmarks/BenchmarkUtils.h"
+
+namespace Bench
+{
+	/**
+	* Solves a cloth-like grid of distance constraints with the scalar
+	* PositionalConstraint::Solve path and the batched SIMD kernel, and compares time and results.
+	*/
+	bool RunPositionalKernelBenchmark(const BenchmarkOptions& options);
+}
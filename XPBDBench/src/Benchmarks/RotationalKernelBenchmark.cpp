@@ -0,0 +1,145 @@
+#include "RotationalKernelBenchmark.h"
+
+#include "Constraints/RotationalConstraint.h"
+#include "Constraints/RotationalConstraintBatch.h"
+#include "Constraints/TransformationData.h"
+#include "Simulation/BodyStore.h"
+#include "Simulation/ConstraintColoring.h"
+#include "Simulation/Simd.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Bench
+{
+	namespace
+	{
+		constexpr float SUBSTEP_TIME = 1.0f / 480.0f;
+		constexpr uint32_t CHAIN_LENGTH = 16;
+
+		void BuildChains(const uint32_t numChains, Simulation::BodyStore& bodies, std::vector<Simulation::RotationalConstraint>& constraints)
+		{
+			using namespace Simulation;
+			Random random(4321);
+
+			for (uint32_t chain = 0; chain < numChains; ++chain)
+			{
+				for (uint32_t link = 0; link < CHAIN_LENGTH; ++link)
+				{
+					BodyDesc desc;
+					desc.InverseMass = random.Range(0.5f, 2.0f);
+					desc.InertiaTensor = Eigen::Vector3f(random.Range(0.05f, 0.2f), random.Range(0.05f, 0.2f), random.Range(0.05f, 0.2f)).asDiagonal();
+					desc.IsStaticBody = (link == 0);
+
+					const BodyHandle body = bodies.Add(desc);
+					const Eigen::Vector3f axis = Eigen::Vector3f(random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f)).normalized();
+					bodies.Rotations[body] = Eigen::Quaternionf(Eigen::AngleAxisf(random.Range(-0.5f, 0.5f), axis));
+
+					if (link > 0)
+					{
+						RotationalConstraint constraint;
+						constraint.Body1 = body - 1;
+						constraint.Body2 = body;
+						constraint.Compliance = random.Range(0.0f, 1e-5f);
+						constraints.push_back(constraint);
+					}
+				}
+			}
+		}
+
+		double SolveScalar(Simulation::BodyStore& bodies, std::vector<Simulation::RotationalConstraint>& constraints,
+			const Simulation::ConstraintColoring& coloring, const uint32_t iterations)
+		{
+			using namespace Simulation;
+			std::vector<TransformationData> transformationData(constraints.size());
+
+			Timer timer;
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				SolveColored(coloring, [&](const uint32_t j)
+				{
+					if (i == 0)
+					{
+						constraints[j].Init();
+						transformationData[j] = GetTransformationData(bodies, constraints[j].Body1, constraints[j].Body2);
+					}
+					constraints[j].Solve(transformationData[j], SUBSTEP_TIME);
+				});
+			}
+			return timer.ElapsedMilliseconds();
+		}
+
+		double SolveBatched(Simulation::BodyStore& bodies, std::vector<Simulation::RotationalConstraint>& constraints,
+			const Simulation::ConstraintColoring& coloring, const uint32_t iterations)
+		{
+			using namespace Simulation;
+			RotationalConstraintBatch batch;
+			batch.Build(constraints, coloring);
+
+			Timer timer;
+			batch.Init();
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				batch.Solve(bodies, SUBSTEP_TIME);
+			}
+			const double elapsed = timer.ElapsedMilliseconds();
+
+			batch.StoreLambdas(constraints);
+			return elapsed;
+		}
+	}
+
+	bool RunRotationalKernelBenchmark(const BenchmarkOptions& options)
+	{
+		using namespace Simulation;
+
+		BodyStore initialBodies;
+		std::vector<RotationalConstraint> initialConstraints;
+		BuildChains(options.Size * options.Size / CHAIN_LENGTH, initialBodies, initialConstraints);
+		initialBodies.UpdateTransformCache();
+
+		ConstraintColoring coloring;
+		coloring.Build(initialBodies, initialConstraints);
+
+		BodyStore scalarBodies = initialBodies;
+		std::vector<RotationalConstraint> scalarConstraints = initialConstraints;
+		const double scalarTime = SolveScalar(scalarBodies, scalarConstraints, coloring, options.Iterations);
+
+		BodyStore batchedBodies = initialBodies;
+		std::vector<RotationalConstraint> batchedConstraints = initialConstraints;
+		const double batchedTime = SolveBatched(batchedBodies, batchedConstraints, coloring, options.Iterations);
+
+		size_t mismatches = 0;
+		for (BodyHandle body = 0; body < scalarBodies.Size(); ++body)
+		{
+			if (memcmp(scalarBodies.Rotations[body].coeffs().data(), batchedBodies.Rotations[body].coeffs().data(), 4 * sizeof(float)) != 0)
+			{
+				++mismatches;
+			}
+		}
+		for (size_t i = 0; i < scalarConstraints.size(); ++i)
+		{
+			if (memcmp(&scalarConstraints[i].Lambda, &batchedConstraints[i].Lambda, sizeof(float)) != 0)
+			{
+				++mismatches;
+			}
+		}
+
+		const double solves = (double)initialConstraints.size() * options.Iterations;
+		printf("RotationalConstraint kernel: %zu constraints, %zu colors, %u iterations, %u lanes\n",
+			initialConstraints.size(), coloring.GetNumColors(), options.Iterations, Simd::LANE_WIDTH);
+		printf("  scalar  : %9.3f ms (%.2f ns/constraint)\n", scalarTime, scalarTime * 1e6 / solves);
+		printf("  batched : %9.3f ms (%.2f ns/constraint), %.2fx\n", batchedTime, batchedTime * 1e6 / solves, scalarTime / batchedTime);
+#if defined(XPBD_STRICT_FP)
+		printf("  bitwise mismatches: %zu (strict FP, expected 0)\n", mismatches);
+
+		// Strict FP guarantees bit-identical results, any mismatch fails the run.
+		return mismatches == 0;
+#else
+		printf("  bitwise mismatches: %zu (build with --strictfp to guarantee 0)\n", mismatches);
+
+		return true;
+#endif
+	}
+}
\ No newline at end of file
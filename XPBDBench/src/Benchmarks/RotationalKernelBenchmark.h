@@ -0,0 +1,11 @@
+#pragma once
+#include "Benchmarks/BenchmarkUtils.h"
+
+namespace Bench
+{
+	/**
+	* Solves chains of rotational constraints with the scalar RotationalConstraint::Solve path and the
+	* batched SIMD kernel. Reports timings and how many rotations differ bitwise between the two.
+	*/
+	bool RunRotationalKernelBenchmark(const BenchmarkOptions& options);
+}
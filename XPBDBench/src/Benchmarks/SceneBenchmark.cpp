@@ -0,0 +1,170 @@
+#include "SceneBenchmark.h"
+#include "HeadlessScenes.h"
+#include "HeapCounter.h"
+
+#include "Simulation/JobSystem.h"
+#include "Simulation/Simd.h"
+#include "Simulation/StateHash.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+
+namespace Bench
+{
+	namespace
+	{
+		// Frames stepped before the heap allocations are counted, the contact and island buffers reach their working size by then.
+		constexpr uint32_t HEAP_WARMUP_FRAMES = 60;
+
+		struct SceneResult
+		{
+			std::string Scene;
+			uint32_t Threads = 0;
+			size_t Bodies = 0;
+			uint64_t Steps = 0;
+			uint64_t ConstraintSolves = 0;
+			double Milliseconds = 0.0;
+			uint64_t StateHash = 0;
+			// Heap allocations after the warm-up frames, 0 when the scene was not stepped past them
+			uint64_t HeapAllocations = 0;
+
+			double StepsPerSecond() const
+			{
+				return Milliseconds > 0.0 ? Steps * 1e3 / Milliseconds : 0.0;
+			}
+
+			double NanosecondsPerBodySubstep(const int substeps) const
+			{
+				const double bodySubsteps = (double)Bodies * substeps * Steps;
+				return bodySubsteps > 0.0 ? Milliseconds * 1e6 / bodySubsteps : 0.0;
+			}
+
+			double NanosecondsPerConstraintSolve() const
+			{
+				return ConstraintSolves > 0 ? Milliseconds * 1e6 / ConstraintSolves : 0.0;
+			}
+		};
+
+		SceneResult StepScene(const std::string& sceneName, const BenchmarkOptions& options, const uint32_t threads)
+		{
+			Simulation::JobSystem::Get().SetNumWorkers(threads);
+
+			// A new scene for every run, so each one starts from the reset state.
+			std::unique_ptr<Simulation::SceneSimulation> scene = CreateHeadlessScene(sceneName);
+			scene->SetSubsteps(options.Substeps);
+			scene->SetNumPosIterations(options.PosIterations);
+
+			uint64_t warmHeapAllocations = 0;
+			Timer timer;
+			for (uint32_t frame = 0; frame < options.Frames; ++frame)
+			{
+				if (frame == HEAP_WARMUP_FRAMES)
+				{
+					warmHeapAllocations = GetNumHeapAllocations();
+				}
+				scene->Step();
+			}
+
+			SceneResult result;
+			result.Milliseconds = timer.ElapsedMilliseconds();
+			result.HeapAllocations = options.Frames > HEAP_WARMUP_FRAMES ? GetNumHeapAllocations() - warmHeapAllocations : 0;
+			result.Scene = sceneName;
+			result.Threads = threads;
+			result.Bodies = scene->GetBodies().Size();
+			result.Steps = scene->GetStepCount();
+			result.ConstraintSolves = scene->GetConstraintSolves();
+			result.StateHash = Simulation::HashBodyState(scene->GetBodies());
+			return result;
+		}
+
+		void PrintText(const std::vector<SceneResult>& results, const BenchmarkOptions& options)
+		{
+			printf("Scene stepping: %u frames, %d substeps, %d position iterations, %u lanes\n",
+				options.Frames, options.Substeps, options.PosIterations, Simulation::Simd::LANE_WIDTH);
+			for (const SceneResult& result : results)
+			{
+				printf("  %-20s %2u threads, %3zu bodies: %10.1f steps/s, %8.2f ns/body-substep, %8.2f ns/constraint, %4" PRIu64 " heap allocations, hash %016" PRIx64 "\n",
+					result.Scene.c_str(), result.Threads, result.Bodies, result.StepsPerSecond(),
+					result.NanosecondsPerBodySubstep(options.Substeps), result.NanosecondsPerConstraintSolve(), result.HeapAllocations, result.StateHash);
+			}
+		}
+
+		void PrintJson(const std::vector<SceneResult>& results, const BenchmarkOptions& options)
+		{
+			printf("{\n");
+			printf("  \"benchmark\": \"scene-step\",\n");
+			printf("  \"frames\": %u,\n", options.Frames);
+			printf("  \"substeps\": %d,\n", options.Substeps);
+			printf("  \"position_iterations\": %d,\n", options.PosIterations);
+			printf("  \"lanes\": %u,\n", Simulation::Simd::LANE_WIDTH);
+			printf("  \"results\": [\n");
+			for (size_t i = 0; i < results.size(); ++i)
+			{
+				const SceneResult& result = results[i];
+				printf("    { \"scene\": \"%s\", \"threads\": %u, \"bodies\": %zu, \"steps\": %" PRIu64 ", \"constraint_solves\": %" PRIu64 ", "
+					"\"milliseconds\": %.3f, \"steps_per_second\": %.3f, \"ns_per_body_substep\": %.3f, \"ns_per_constraint_solve\": %.3f, "
+					"\"heap_allocations\": %" PRIu64 ", \"state_hash\": \"%016" PRIx64 "\" }%s\n",
+					result.Scene.c_str(), result.Threads, result.Bodies, result.Steps, result.ConstraintSolves,
+					result.Milliseconds, result.StepsPerSecond(), result.NanosecondsPerBodySubstep(options.Substeps), result.NanosecondsPerConstraintSolve(),
+					result.HeapAllocations, result.StateHash, i + 1 < results.size() ? "," : "");
+			}
+			printf("  ]\n");
+			printf("}\n");
+		}
+	}
+
+	bool RunSceneBenchmark(const BenchmarkOptions& options)
+	{
+		std::vector<std::string> sceneNames;
+		if (options.Scene.empty())
+		{
+			sceneNames = GetHeadlessSceneNames();
+		}
+		else if (CreateHeadlessScene(options.Scene))
+		{
+			sceneNames.push_back(options.Scene);
+		}
+		else
+		{
+			fprintf(stderr, "Unknown scene '%s'\n", options.Scene.c_str());
+			return false;
+		}
+
+		const std::vector<uint32_t> threadCounts = options.ThreadCounts.empty() ? std::vector<uint32_t>{ options.Threads } : options.ThreadCounts;
+
+		std::vector<SceneResult> results;
+		for (const std::string& sceneName : sceneNames)
+		{
+			for (const uint32_t threads : threadCounts)
+			{
+				results.push_back(StepScene(sceneName, options, threads));
+			}
+		}
+
+		// The other benchmarks keep running with the worker count they were given.
+		Simulation::JobSystem::Get().SetNumWorkers(options.Threads);
+
+		if (options.Json)
+		{
+			PrintJson(results, options);
+		}
+		else
+		{
+			PrintText(results, options);
+		}
+
+		// Warmed up scenes reuse their buffers, any allocation left is a regression.
+		bool steadyStateAllocates = false;
+		for (const SceneResult& result : results)
+		{
+			if (result.HeapAllocations > 0)
+			{
+				fprintf(stderr, "%s with %u threads made %" PRIu64 " heap allocations after %u warm-up frames\n",
+					result.Scene.c_str(), result.Threads, result.HeapAllocations, HEAP_WARMUP_FRAMES);
+				steadyStateAllocates = true;
+			}
+		}
+		return !steadyStateAllocates;
+	}
+}
\ No newline at end of file
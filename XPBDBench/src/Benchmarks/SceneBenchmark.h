@@ -0,0 +1,14 @@
+#pragma once
+#include "Benchmarks/BenchmarkUtils.h"
+
+namespace Bench
+{
+	/**
+	* Steps the simulation behind every Engine scene for Frames fixed steps at the given substeps,
+	* position iterations and worker counts. Reports steps per second, ns per body substep and
+	* ns per constraint solve, plus the final state hash so runs can be checked against each other.
+	* Also counts the heap allocations made once the scene is warmed up, and fails if stepping still allocates.
+	* With Json set the results are printed as a single JSON document instead of text.
+	*/
+	bool RunSceneBenchmark(const BenchmarkOptions& options);
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "Benchmarks/BenchmarkUtils.h"
+#include "Benchmarks/BroadphaseBenchmark.h"
+#include "Benchmarks/GjkBenchmark.h"
+#include "Benchmarks/PositionalKernelBenchmark.h"
+#include "Benchmarks/RotationalKernelBenchmark.h"
+#include "Benchmarks/SceneBenchmark.h"
+
+#include "Simulation/JobSystem.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct BenchmarkEntry
+	{
+		const char* Name;
+		// Returns false when a check of the benchmark failed
+		bool (*Run)(const Bench::BenchmarkOptions&);
+	};
+
+	const BenchmarkEntry Benchmarks[] = {
+		{ "positional-kernel", Bench::RunPositionalKernelBenchmark },
+		{ "rotational-kernel", Bench::RunRotationalKernelBenchmark },
+		{ "broadphase-build", Bench::RunBroadphaseBenchmark },
+		{ "gjk-warmstart", Bench::RunGjkBenchmark },
+		{ "scene-step", Bench::RunSceneBenchmark },
+	};
+
+	void PrintUsage()
+	{
+		printf("Usage: XPBDBench [benchmark] [--threads N] [--iterations N] [--size N]\n");
+		printf("       XPBDBench scene-step [--scene Name] [--frames N] [--substeps N] [--pos-iterations N] [--thread-counts N,N,...] [--json]\n");
+		printf("Benchmarks:\n");
+		for (const BenchmarkEntry& benchmark : Benchmarks)
+		{
+			printf("  %s\n", benchmark.Name);
+		}
+	}
+
+	void ParseThreadCounts(const char* list, std::vector<uint32_t>& threadCounts)
+	{
+		threadCounts.clear();
+		for (const char* count = list; *count != '\0';)
+		{
+			char* end = nullptr;
+			const unsigned long threads = strtoul(count, &end, 10);
+			if (end == count)
+			{
+				break;
+			}
+
+			threadCounts.push_back((uint32_t)threads);
+			count = (*end == ',') ? end + 1 : end;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Bench::BenchmarkOptions options;
+	const char* selected = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = (i + 1 < argc);
+		if (strcmp(argv[i], "--threads") == 0 && hasValue)
+		{
+			options.Threads = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--iterations") == 0 && hasValue)
+		{
+			options.Iterations = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--size") == 0 && hasValue)
+		{
+			options.Size = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && hasValue)
+		{
+			options.Frames = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--substeps") == 0 && hasValue)
+		{
+			options.Substeps = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--pos-iterations") == 0 && hasValue)
+		{
+			options.PosIterations = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--thread-counts") == 0 && hasValue)
+		{
+			ParseThreadCounts(argv[++i], options.ThreadCounts);
+		}
+		else if (strcmp(argv[i], "--scene") == 0 && hasValue)
+		{
+			options.Scene = argv[++i];
+		}
+		else if (strcmp(argv[i], "--json") == 0)
+		{
+			options.Json = true;
+		}
+		else if (argv[i][0] != '-')
+		{
+			selected = argv[i];
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	// Kernel timings default to a single thread so they measure the kernel and not the scheduling.
+	Simulation::JobSystem::Get().SetNumWorkers(options.Threads);
+
+	bool found = false;
+	bool passed = true;
+	for (const BenchmarkEntry& benchmark : Benchmarks)
+	{
+		if (selected == nullptr || strcmp(selected, benchmark.Name) == 0)
+		{
+			passed &= benchmark.Run(options);
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Simulation::JobSystem::Get().Shutdown();
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#include "Aabb.h"
+
+namespace Simulation
+{
+	Aabb ComputeBodyAabb(BodyStore& bodies, BodyHandle body)
+	{
+		const Collider& collider = bodies.Colliders[body];
+		const Eigen::Vector3f& position = bodies.Positions[body];
+
+		switch (collider.Type)
+		{
+		case ColliderType::Box:
+		{
+			// Extents of a rotated box along the world axes are |R| * halfExtents.
+			const Eigen::Vector3f halfExtents = collider.HalfExtents.cwiseProduct(bodies.Scales[body]);
+			const Eigen::Vector3f worldExtents = bodies.GetRotationMatrix(body).cwiseAbs() * halfExtents;
+			return Aabb{ position - worldExtents, position + worldExtents };
+		}
+		case ColliderType::Sphere:
+		{
+			const float radius = collider.Radius * bodies.Scales[body].maxCoeff();
+			return Aabb{ position.array() - radius, position.array() + radius };
+		}
+		default:
+			return Aabb{};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include <cfloat>
+#include <Eigen/Dense>
+
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	struct Aabb
+	{
+		Eigen::Vector3f Min = Eigen::Vector3f::Constant(FLT_MAX);
+		Eigen::Vector3f Max = Eigen::Vector3f::Constant(-FLT_MAX);
+
+		bool Overlaps(const Aabb& other) const
+		{
+			return (Min.array() <= other.Max.array()).all() && (other.Min.array() <= Max.array()).all();
+		}
+
+		bool Contains(const Aabb& other) const
+		{
+			return (Min.array() <= other.Min.array()).all() && (other.Max.array() <= Max.array()).all();
+		}
+
+		Aabb Merged(const Aabb& other) const
+		{
+			return Aabb{ Min.cwiseMin(other.Min), Max.cwiseMax(other.Max) };
+		}
+
+		Aabb Fattened(const float margin) const
+		{
+			return Aabb{ Min.array() - margin, Max.array() + margin };
+		}
+
+		Eigen::Vector3f Center() const
+		{
+			return 0.5f * (Min + Max);
+		}
+
+		float SurfaceArea() const
+		{
+			const Eigen::Vector3f extents = Max - Min;
+			return 2.0f * (extents.x() * extents.y() + extents.y() * extents.z() + extents.z() * extents.x());
+		}
+	};
+
+	/**
+	* Pair of bodies whose bounds overlap, Body1 < Body2.
+	*/
+	struct BodyPair
+	{
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+	};
+
+	/**
+	* World space bounds of the body collider, using the cached rotation matrix.
+	* Bodies without a collider get an empty box.
+	*/
+	Aabb ComputeBodyAabb(BodyStore& bodies, BodyHandle body);
+}
\ No newline at end of file
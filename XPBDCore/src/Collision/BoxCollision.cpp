@@ -0,0 +1,416 @@
+#include "BoxCollision.h"
+#include "Simulation/Simd.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Simulation
+{
+	namespace
+	{
+		constexpr uint32_t NUM_AXES = 15;
+		constexpr uint32_t NUM_AXIS_SLOTS = 16;
+		// Keeps the cross products of nearly parallel edges from producing a bogus axis
+		constexpr float AXIS_EPSILON = 1e-6f;
+		// A later axis has to beat the current one by this much, so the choice does not flicker between frames
+		constexpr float RELATIVE_TOLERANCE = 0.98f;
+		constexpr float ABSOLUTE_TOLERANCE = 0.001f;
+
+		// Clipped points this far above the reference face are kept, so resting faces report every corner
+		constexpr float CONTACT_SLOP = 0.005f;
+
+		constexpr uint32_t MAX_CLIP_POINTS = 8;
+		constexpr uint32_t EDGE_CONTACT_FEATURE = 0x80000000u;
+
+		struct ClipPoint
+		{
+			Eigen::Vector3f Position;
+			uint32_t FeatureId;
+		};
+
+		struct ClipPolygon
+		{
+			ClipPoint Points[MAX_CLIP_POINTS];
+			uint32_t Count = 0;
+		};
+
+		bool IsBetter(const float separation, const float bestSeparation)
+		{
+			return separation > RELATIVE_TOLERANCE * bestSeparation + ABSOLUTE_TOLERANCE;
+		}
+
+		/**
+		* Keeps the part of the polygon where dot(normal, p) <= offset.
+		* Points created on the clipping plane get the id of the clipped edge and the plane.
+		*/
+		void ClipPolygonAgainstPlane(const ClipPolygon& input, const Eigen::Vector3f& normal, const float offset, const uint32_t plane, ClipPolygon& output)
+		{
+			output.Count = 0;
+			for (uint32_t i = 0; i < input.Count; ++i)
+			{
+				const ClipPoint& a = input.Points[i];
+				const ClipPoint& b = input.Points[(i + 1) % input.Count];
+				const float distanceA = normal.dot(a.Position) - offset;
+				const float distanceB = normal.dot(b.Position) - offset;
+
+				if (distanceA <= 0.0f)
+				{
+					output.Points[output.Count++] = a;
+				}
+
+				if ((distanceA < 0.0f && distanceB > 0.0f) || (distanceA > 0.0f && distanceB < 0.0f))
+				{
+					const float t = distanceA / (distanceA - distanceB);
+					output.Points[output.Count++] = ClipPoint{ a.Position + t * (b.Position - a.Position), 4 + 4 * (a.FeatureId & 0x3) + plane };
+				}
+			}
+		}
+
+		/**
+		* Picks up to MAX_CONTACT_POINTS indices that keep the deepest point and span the largest area.
+		*/
+		uint32_t ReduceContactPoints(const ClipPoint* points, const float* depths, const uint32_t count, const Eigen::Vector3f& normal, uint32_t* selected)
+		{
+			if (count <= MAX_CONTACT_POINTS)
+			{
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					selected[i] = i;
+				}
+				return count;
+			}
+
+			uint32_t deepest = 0;
+			for (uint32_t i = 1; i < count; ++i)
+			{
+				if (depths[i] > depths[deepest])
+				{
+					deepest = i;
+				}
+			}
+
+			uint32_t farthest = deepest;
+			float farthestDistance = -1.0f;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const float distance = (points[i].Position - points[deepest].Position).squaredNorm();
+				if (distance > farthestDistance)
+				{
+					farthest = i;
+					farthestDistance = distance;
+				}
+			}
+
+			// The last two points maximize the triangle area on either side of the first edge.
+			const Eigen::Vector3f edge = points[farthest].Position - points[deepest].Position;
+			uint32_t positive = count;
+			uint32_t negative = count;
+			float maxArea = 0.0f;
+			float minArea = 0.0f;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (i == deepest || i == farthest)
+				{
+					continue;
+				}
+
+				const float area = normal.dot(edge.cross(points[i].Position - points[deepest].Position));
+				if (area > maxArea)
+				{
+					maxArea = area;
+					positive = i;
+				}
+				if (area < minArea)
+				{
+					minArea = area;
+					negative = i;
+				}
+			}
+
+			uint32_t numSelected = 0;
+			selected[numSelected++] = deepest;
+			selected[numSelected++] = farthest;
+			if (positive < count)
+			{
+				selected[numSelected++] = positive;
+			}
+			if (negative < count)
+			{
+				selected[numSelected++] = negative;
+			}
+			return numSelected;
+		}
+
+		/**
+		* Clips the face of the incident box that faces the reference face against the sides of the reference face.
+		* normal is the reference face normal, pointing from the reference box towards the incident box.
+		*/
+		bool CollideFaces(const OrientedBox& reference, const OrientedBox& incident, const uint32_t referenceAxis,
+			const Eigen::Vector3f& normal, const bool referenceIsBody1, ContactManifold& manifold)
+		{
+			// Incident face: the one whose normal is most anti-parallel to the reference normal
+			const Eigen::Vector3f incidentDots = incident.Axes.transpose() * normal;
+			uint32_t incidentAxis = 0;
+			incidentDots.cwiseAbs().maxCoeff(&incidentAxis);
+			const float incidentSign = incidentDots(incidentAxis) > 0.0f ? -1.0f : 1.0f;
+
+			const uint32_t incidentAxis1 = (incidentAxis + 1) % 3;
+			const uint32_t incidentAxis2 = (incidentAxis + 2) % 3;
+			const Eigen::Vector3f incidentCenter = incident.Center + incidentSign * incident.HalfExtents(incidentAxis) * incident.Axes.col(incidentAxis);
+			const Eigen::Vector3f incidentU = incident.HalfExtents(incidentAxis1) * incident.Axes.col(incidentAxis1);
+			const Eigen::Vector3f incidentV = incident.HalfExtents(incidentAxis2) * incident.Axes.col(incidentAxis2);
+
+			ClipPolygon polygon;
+			polygon.Count = 4;
+			polygon.Points[0] = ClipPoint{ incidentCenter + incidentU + incidentV, 0 };
+			polygon.Points[1] = ClipPoint{ incidentCenter - incidentU + incidentV, 1 };
+			polygon.Points[2] = ClipPoint{ incidentCenter - incidentU - incidentV, 2 };
+			polygon.Points[3] = ClipPoint{ incidentCenter + incidentU - incidentV, 3 };
+
+			// Side planes of the reference face
+			const uint32_t referenceAxis1 = (referenceAxis + 1) % 3;
+			const uint32_t referenceAxis2 = (referenceAxis + 2) % 3;
+			const Eigen::Vector3f referenceCenter = reference.Center + reference.HalfExtents(referenceAxis) * normal;
+			const Eigen::Vector3f sideU = reference.Axes.col(referenceAxis1);
+			const Eigen::Vector3f sideV = reference.Axes.col(referenceAxis2);
+			const float centerU = sideU.dot(reference.Center);
+			const float centerV = sideV.dot(reference.Center);
+
+			ClipPolygon clipped;
+			ClipPolygonAgainstPlane(polygon, sideU, centerU + reference.HalfExtents(referenceAxis1), 0, clipped);
+			ClipPolygonAgainstPlane(clipped, -sideU, -centerU + reference.HalfExtents(referenceAxis1), 1, polygon);
+			ClipPolygonAgainstPlane(polygon, sideV, centerV + reference.HalfExtents(referenceAxis2), 2, clipped);
+			ClipPolygonAgainstPlane(clipped, -sideV, -centerV + reference.HalfExtents(referenceAxis2), 3, polygon);
+
+			// Keep the points below the reference face, or just above it
+			ClipPoint points[MAX_CLIP_POINTS];
+			float depths[MAX_CLIP_POINTS];
+			uint32_t count = 0;
+			for (uint32_t i = 0; i < polygon.Count; ++i)
+			{
+				const float depth = normal.dot(referenceCenter - polygon.Points[i].Position);
+				if (depth >= -CONTACT_SLOP)
+				{
+					points[count] = polygon.Points[i];
+					depths[count] = depth;
+					++count;
+				}
+			}
+
+			if (count == 0)
+			{
+				return false;
+			}
+
+			uint32_t selected[MAX_CONTACT_POINTS];
+			const uint32_t numSelected = ReduceContactPoints(points, depths, count, normal, selected);
+
+			const uint32_t referenceSide = normal.dot(reference.Axes.col(referenceAxis)) > 0.0f ? 1u : 0u;
+			const uint32_t faceIds = ((referenceIsBody1 ? 0u : 1u) << 24)
+				| ((referenceAxis * 2 + referenceSide) << 16)
+				| ((incidentAxis * 2 + (incidentSign > 0.0f ? 1u : 0u)) << 8);
+
+			manifold.Normal = referenceIsBody1 ? normal : Eigen::Vector3f(-normal);
+			manifold.NumPoints = numSelected;
+			for (uint32_t i = 0; i < numSelected; ++i)
+			{
+				const ClipPoint& point = points[selected[i]];
+				const float depth = depths[selected[i]];
+				const Eigen::Vector3f onReference = point.Position + depth * normal;
+
+				ContactPoint& contact = manifold.Points[i];
+				contact.PointOnBody1 = referenceIsBody1 ? onReference : point.Position;
+				contact.PointOnBody2 = referenceIsBody1 ? point.Position : onReference;
+				contact.Depth = depth;
+				contact.FeatureId = faceIds | point.FeatureId;
+			}
+			return true;
+		}
+
+		/**
+		* Closest points between the two edges that are parallel to box1 axis i and box2 axis j and closest along the normal.
+		*/
+		void CollideEdges(const OrientedBox& box1, const OrientedBox& box2, const uint32_t axis1, const uint32_t axis2,
+			const Eigen::Vector3f& normal, const float separation, ContactManifold& manifold)
+		{
+			// Edge of box1 furthest along the normal and edge of box2 furthest against it
+			Eigen::Vector3f point1 = box1.Center;
+			Eigen::Vector3f point2 = box2.Center;
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				if (k != axis1)
+				{
+					const Eigen::Vector3f axis = box1.Axes.col(k);
+					point1 += (axis.dot(normal) > 0.0f ? 1.0f : -1.0f) * box1.HalfExtents(k) * axis;
+				}
+				if (k != axis2)
+				{
+					const Eigen::Vector3f axis = box2.Axes.col(k);
+					point2 += (axis.dot(normal) > 0.0f ? -1.0f : 1.0f) * box2.HalfExtents(k) * axis;
+				}
+			}
+
+			const Eigen::Vector3f direction1 = box1.Axes.col(axis1);
+			const Eigen::Vector3f direction2 = box2.Axes.col(axis2);
+			const Eigen::Vector3f offset = point1 - point2;
+			const float d12 = direction1.dot(direction2);
+			const float denominator = 1.0f - d12 * d12;
+
+			float s = 0.0f;
+			float t = 0.0f;
+			if (denominator > AXIS_EPSILON)
+			{
+				const float d1 = direction1.dot(offset);
+				const float d2 = direction2.dot(offset);
+				s = (d12 * d2 - d1) / denominator;
+				t = (d2 - d12 * d1) / denominator;
+			}
+			s = std::clamp(s, -box1.HalfExtents(axis1), box1.HalfExtents(axis1));
+			t = std::clamp(t, -box2.HalfExtents(axis2), box2.HalfExtents(axis2));
+
+			manifold.Normal = normal;
+			manifold.NumPoints = 1;
+			ContactPoint& contact = manifold.Points[0];
+			contact.PointOnBody1 = point1 + s * direction1;
+			contact.PointOnBody2 = point2 + t * direction2;
+			contact.Depth = -separation;
+			contact.FeatureId = EDGE_CONTACT_FEATURE | (axis1 << 4) | axis2;
+		}
+	}
+
+	OrientedBox MakeOrientedBox(BodyStore& bodies, BodyHandle body)
+	{
+		OrientedBox box;
+		box.Center = bodies.Positions[body];
+		box.Axes = bodies.GetRotationMatrix(body);
+		box.HalfExtents = bodies.Colliders[body].HalfExtents.cwiseProduct(bodies.Scales[body]);
+		return box;
+	}
+
+	bool CollideBoxes(const OrientedBox& box1, const OrientedBox& box2, ContactManifold& manifold)
+	{
+		manifold.NumPoints = 0;
+
+		// Everything below is expressed in the frame of box1, R(i, j) = dot(A_i, B_j).
+		const Eigen::Matrix3f R = box1.Axes.transpose() * box2.Axes;
+		const Eigen::Matrix3f absR = R.cwiseAbs().array() + AXIS_EPSILON;
+		const Eigen::Vector3f t = box1.Axes.transpose() * (box2.Center - box1.Center);
+		const Eigen::Vector3f& a = box1.HalfExtents;
+		const Eigen::Vector3f& b = box2.HalfExtents;
+
+		// Per axis: projected center distance, summed projected radii and squared axis length.
+		alignas(32) float distances[NUM_AXIS_SLOTS];
+		alignas(32) float radii[NUM_AXIS_SLOTS];
+		alignas(32) float lengthsSq[NUM_AXIS_SLOTS];
+		alignas(32) float separations[NUM_AXIS_SLOTS];
+
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			// Faces of box1
+			distances[i] = t(i);
+			radii[i] = a(i) + absR.row(i).dot(b);
+			lengthsSq[i] = 1.0f;
+
+			// Faces of box2
+			distances[3 + i] = t.dot(R.col(i));
+			radii[3 + i] = absR.col(i).dot(a) + b(i);
+			lengthsSq[3 + i] = 1.0f;
+		}
+
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const uint32_t i1 = (i + 1) % 3;
+			const uint32_t i2 = (i + 2) % 3;
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				// A_i x B_j
+				const uint32_t j1 = (j + 1) % 3;
+				const uint32_t j2 = (j + 2) % 3;
+				const uint32_t axis = 6 + 3 * i + j;
+				distances[axis] = t(i2) * R(i1, j) - t(i1) * R(i2, j);
+				radii[axis] = a(i1) * absR(i2, j) + a(i2) * absR(i1, j) + b(j1) * absR(i, j2) + b(j2) * absR(i, j1);
+				lengthsSq[axis] = R(i1, j) * R(i1, j) + R(i2, j) * R(i2, j);
+			}
+		}
+
+		// Padding lane, never selected
+		distances[NUM_AXES] = 0.0f;
+		radii[NUM_AXES] = FLT_MAX;
+		lengthsSq[NUM_AXES] = 1.0f;
+
+		using namespace Simd;
+		const FloatLanes signMask = Set1(-0.0f);
+		const FloatLanes minLengthSq = Set1(AXIS_EPSILON);
+		const FloatLanes invalid = Set1(-FLT_MAX);
+		bool separated = false;
+		for (uint32_t lane = 0; lane < NUM_AXIS_SLOTS; lane += LANE_WIDTH)
+		{
+			const FloatLanes lengthSq = Load(lengthsSq + lane);
+			const FloatLanes separation = (AndNot(signMask, Load(distances + lane)) - Load(radii + lane)) / Sqrt(Max(lengthSq, minLengthSq));
+			// Parallel edges give no axis, the face axes already cover them.
+			const FloatLanes result = Select(lengthSq > minLengthSq, separation, invalid);
+			separated |= AnyTrue(result > Zero());
+			Store(separations + lane, result);
+		}
+
+		if (separated)
+		{
+			return false;
+		}
+
+		// Prefer faces of box1, then faces of box2, then edges.
+		auto findBest = [&](const uint32_t begin, const uint32_t end)
+		{
+			uint32_t best = begin;
+			for (uint32_t axis = begin + 1; axis < end; ++axis)
+			{
+				if (separations[axis] > separations[best])
+				{
+					best = axis;
+				}
+			}
+			return best;
+		};
+
+		uint32_t bestAxis = findBest(0, 3);
+		const uint32_t bestFace2 = findBest(3, 6);
+		if (IsBetter(separations[bestFace2], separations[bestAxis]))
+		{
+			bestAxis = bestFace2;
+		}
+		const uint32_t bestEdge = findBest(6, NUM_AXES);
+		if (IsBetter(separations[bestEdge], separations[bestAxis]))
+		{
+			bestAxis = bestEdge;
+		}
+
+		const Eigen::Vector3f centerOffset = box2.Center - box1.Center;
+		if (bestAxis < 3)
+		{
+			const Eigen::Vector3f axis = box1.Axes.col(bestAxis);
+			const Eigen::Vector3f normal = axis.dot(centerOffset) < 0.0f ? Eigen::Vector3f(-axis) : axis;
+			return CollideFaces(box1, box2, bestAxis, normal, true, manifold);
+		}
+
+		if (bestAxis < 6)
+		{
+			const uint32_t axisIndex = bestAxis - 3;
+			const Eigen::Vector3f axis = box2.Axes.col(axisIndex);
+			// Reference normal of box2 points towards box1
+			const Eigen::Vector3f normal = axis.dot(centerOffset) > 0.0f ? Eigen::Vector3f(-axis) : axis;
+			return CollideFaces(box2, box1, axisIndex, normal, false, manifold);
+		}
+
+		const uint32_t edgeIndex = bestAxis - 6;
+		const uint32_t axis1 = edgeIndex / 3;
+		const uint32_t axis2 = edgeIndex % 3;
+		Eigen::Vector3f normal = box1.Axes.col(axis1).cross(box2.Axes.col(axis2)).normalized();
+		if (normal.dot(centerOffset) < 0.0f)
+		{
+			normal = -normal;
+		}
+		CollideEdges(box1, box2, axis1, axis2, normal, separations[bestAxis], manifold);
+		return true;
+	}
+}
\ No newline at end of file
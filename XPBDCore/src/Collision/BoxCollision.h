@@ -0,0 +1,29 @@
+#pragma once
+#include <Eigen/Dense>
+
+#include "Collision/ContactManifold.h"
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	struct OrientedBox
+	{
+		Eigen::Vector3f Center = Eigen::Vector3f::Zero();
+		// Columns are the box axes in world space
+		Eigen::Matrix3f Axes = Eigen::Matrix3f::Identity();
+		Eigen::Vector3f HalfExtents = Eigen::Vector3f::Constant(0.5f);
+	};
+
+	/**
+	* World space box of a body with a box collider, using the cached rotation matrix.
+	*/
+	OrientedBox MakeOrientedBox(BodyStore& bodies, BodyHandle body);
+
+	/**
+	* Separating axis test between two oriented boxes, the 15 candidate axes are evaluated in SIMD lanes.
+	* Face contacts clip the incident face against the reference face and keep at most 4 points,
+	* edge contacts produce a single point. Fills the normal and points of the manifold but not the bodies.
+	* Returns false when the boxes are separated.
+	*/
+	bool CollideBoxes(const OrientedBox& box1, const OrientedBox& box2, ContactManifold& manifold);
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <Eigen/Dense>
+
+namespace Simulation
+{
+	enum class ColliderType : uint8_t
+	{
+		None = 0,
+		Box,
+		Sphere,
+	};
+
+	/**
+	* Collision shape of a body, in body space before scaling.
+	* The defaults describe the unit cube and sphere that the scenes render, scaled by BodyStore::Scales.
+	*/
+	struct Collider
+	{
+		ColliderType Type = ColliderType::None;
+		Eigen::Vector3f HalfExtents = Eigen::Vector3f::Constant(0.5f);
+		float Radius = 0.5f;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	constexpr uint32_t MAX_CONTACT_POINTS = 4;
+
+	struct ContactPoint
+	{
+		// World space points on the surface of each body
+		Eigen::Vector3f PointOnBody1 = Eigen::Vector3f::Zero();
+		Eigen::Vector3f PointOnBody2 = Eigen::Vector3f::Zero();
+		// Penetration along the normal, positive while the bodies overlap and slightly negative for points about to touch
+		float Depth = 0.0f;
+		// Identifies the pair of features that produced the point, stable while the bodies stay in the same configuration
+		uint32_t FeatureId = 0;
+	};
+
+	/**
+	* Contact points between two bodies, the normal points from Body1 towards Body2.
+	*/
+	struct ContactManifold
+	{
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+		Eigen::Vector3f Normal = Eigen::Vector3f::Zero();
+		uint32_t NumPoints = 0;
+		std::array<ContactPoint, MAX_CONTACT_POINTS> Points;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "Collision/BoxCollision.h"
+
+namespace Simulation
+{
+	/**
+	* Support mappings used by the GJK and EPA templates in Gjk.h.
+	* A shape is a core convex set swept by a sphere of radius GetMargin(shape):
+	* SupportCore(shape, direction) is the furthest core point along direction, which does not need to be normalized.
+	* Any type with these three overloads can be collided, the calls are resolved at compile time.
+	*/
+	struct SphereShape
+	{
+		Eigen::Vector3f Center = Eigen::Vector3f::Zero();
+		float Radius = 0.5f;
+	};
+
+	struct CapsuleShape
+	{
+		// End points of the segment the capsule is swept along
+		Eigen::Vector3f Point1 = Eigen::Vector3f::Zero();
+		Eigen::Vector3f Point2 = Eigen::Vector3f::UnitY();
+		float Radius = 0.5f;
+	};
+
+	/**
+	* Convex hull of body space points, the points are not owned.
+	*/
+	struct ConvexHullShape
+	{
+		const Eigen::Vector3f* Points = nullptr;
+		uint32_t NumPoints = 0;
+
+		Eigen::Vector3f Position = Eigen::Vector3f::Zero();
+		Eigen::Matrix3f Rotation = Eigen::Matrix3f::Identity();
+		Eigen::Vector3f Scale = Eigen::Vector3f::Ones();
+	};
+
+	// Sphere
+	inline Eigen::Vector3f SupportCore(const SphereShape& shape, const Eigen::Vector3f&)
+	{
+		return shape.Center;
+	}
+
+	inline float GetMargin(const SphereShape& shape)
+	{
+		return shape.Radius;
+	}
+
+	inline Eigen::Vector3f GetCenter(const SphereShape& shape)
+	{
+		return shape.Center;
+	}
+
+	// Capsule
+	inline Eigen::Vector3f SupportCore(const CapsuleShape& shape, const Eigen::Vector3f& direction)
+	{
+		return direction.dot(shape.Point2 - shape.Point1) > 0.0f ? shape.Point2 : shape.Point1;
+	}
+
+	inline float GetMargin(const CapsuleShape& shape)
+	{
+		return shape.Radius;
+	}
+
+	inline Eigen::Vector3f GetCenter(const CapsuleShape& shape)
+	{
+		return 0.5f * (shape.Point1 + shape.Point2);
+	}
+
+	// Box
+	inline Eigen::Vector3f SupportCore(const OrientedBox& shape, const Eigen::Vector3f& direction)
+	{
+		const Eigen::Vector3f localDirection = shape.Axes.transpose() * direction;
+		const Eigen::Vector3f signs = localDirection.unaryExpr([](const float d) { return d >= 0.0f ? 1.0f : -1.0f; });
+		return shape.Center + shape.Axes * signs.cwiseProduct(shape.HalfExtents);
+	}
+
+	inline float GetMargin(const OrientedBox&)
+	{
+		return 0.0f;
+	}
+
+	inline Eigen::Vector3f GetCenter(const OrientedBox& shape)
+	{
+		return shape.Center;
+	}
+
+	// Convex hull
+	inline Eigen::Vector3f SupportCore(const ConvexHullShape& shape, const Eigen::Vector3f& direction)
+	{
+		// Scaling is applied to the points, so the direction is transformed by the inverse transpose.
+		const Eigen::Vector3f localDirection = (shape.Rotation.transpose() * direction).cwiseProduct(shape.Scale);
+
+		uint32_t best = 0;
+		float bestDot = localDirection.dot(shape.Points[0]);
+		for (uint32_t i = 1; i < shape.NumPoints; ++i)
+		{
+			const float d = localDirection.dot(shape.Points[i]);
+			if (d > bestDot)
+			{
+				bestDot = d;
+				best = i;
+			}
+		}
+		return shape.Position + shape.Rotation * shape.Points[best].cwiseProduct(shape.Scale);
+	}
+
+	inline float GetMargin(const ConvexHullShape&)
+	{
+		return 0.0f;
+	}
+
+	inline Eigen::Vector3f GetCenter(const ConvexHullShape& shape)
+	{
+		return shape.Position;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,409 @@
+#include "DynamicAabbTree.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Simulation
+{
+	DynamicAabbTree::DynamicAabbTree(const float margin)
+		: m_Margin(margin)
+	{
+	}
+
+	void DynamicAabbTree::Insert(BodyHandle body, const Aabb& bounds)
+	{
+		if (body >= m_BodyNodes.size())
+		{
+			m_BodyNodes.resize(body + 1, NULL_NODE);
+			m_Moved.resize(body + 1, 0);
+		}
+		assert(m_BodyNodes[body] == NULL_NODE);
+
+		const int32_t leaf = AllocateNode();
+		m_Nodes[leaf].Bounds = bounds.Fattened(m_Margin);
+		m_Nodes[leaf].Body = body;
+		m_Nodes[leaf].Height = 0;
+		InsertLeaf(leaf);
+
+		m_BodyNodes[body] = leaf;
+		if (!m_Moved[body])
+		{
+			m_Moved[body] = 1;
+			m_MoveBuffer.push_back(body);
+		}
+	}
+
+	void DynamicAabbTree::Remove(BodyHandle body)
+	{
+		if (!Contains(body))
+		{
+			return;
+		}
+
+		const int32_t leaf = m_BodyNodes[body];
+		RemoveLeaf(leaf);
+		FreeNode(leaf);
+		m_BodyNodes[body] = NULL_NODE;
+
+		// Drop the pairs of the body, the move buffer skips bodies that are no longer in the tree.
+		m_Pairs.erase(std::remove_if(m_Pairs.begin(), m_Pairs.end(),
+			[body](const BodyPair& pair) { return pair.Body1 == body || pair.Body2 == body; }), m_Pairs.end());
+	}
+
+	bool DynamicAabbTree::Move(BodyHandle body, const Aabb& bounds)
+	{
+		const int32_t leaf = m_BodyNodes[body];
+		if (m_Nodes[leaf].Bounds.Contains(bounds))
+		{
+			return false;
+		}
+
+		RemoveLeaf(leaf);
+		m_Nodes[leaf].Bounds = bounds.Fattened(m_Margin);
+		InsertLeaf(leaf);
+
+		if (!m_Moved[body])
+		{
+			m_Moved[body] = 1;
+			m_MoveBuffer.push_back(body);
+		}
+		return true;
+	}
+
+	bool DynamicAabbTree::Contains(BodyHandle body) const
+	{
+		return body < m_BodyNodes.size() && m_BodyNodes[body] != NULL_NODE;
+	}
+
+	const Aabb& DynamicAabbTree::GetFatAabb(BodyHandle body) const
+	{
+		return m_Nodes[m_BodyNodes[body]].Bounds;
+	}
+
+	void DynamicAabbTree::UpdateBodies(BodyStore& bodies)
+	{
+		if (m_BodyNodes.size() > bodies.Size())
+		{
+			Clear();
+		}
+
+		for (BodyHandle body = 0; body < bodies.Size(); ++body)
+		{
+			const bool hasCollider = bodies.Colliders[body].Type != ColliderType::None;
+			if (!Contains(body))
+			{
+				if (hasCollider)
+				{
+					Insert(body, ComputeBodyAabb(bodies, body));
+				}
+				continue;
+			}
+
+			if (!hasCollider)
+			{
+				Remove(body);
+			}
+			else if (!bodies.IsStatic(body))
+			{
+				Move(body, ComputeBodyAabb(bodies, body));
+			}
+		}
+	}
+
+	void DynamicAabbTree::UpdatePairs(const BodyStore& bodies)
+	{
+		// Pairs between two bodies that kept their fat box are still valid.
+		m_PairScratch.clear();
+		for (const BodyPair& pair : m_Pairs)
+		{
+			if (!m_Moved[pair.Body1] && !m_Moved[pair.Body2])
+			{
+				m_PairScratch.push_back(pair);
+			}
+		}
+
+		for (const BodyHandle body : m_MoveBuffer)
+		{
+			if (!Contains(body))
+			{
+				continue;
+			}
+
+			const bool isStatic = bodies.IsStatic(body);
+			QueryOverlap(GetFatAabb(body), [&](const BodyHandle other)
+			{
+				// Pairs of two moved bodies are added by the one with the lower handle.
+				if (other == body || (m_Moved[other] && other < body) || (isStatic && bodies.IsStatic(other)))
+				{
+					return true;
+				}
+
+				m_PairScratch.push_back(body < other ? BodyPair{ body, other } : BodyPair{ other, body });
+				return true;
+			});
+		}
+
+		for (const BodyHandle body : m_MoveBuffer)
+		{
+			m_Moved[body] = 0;
+		}
+		m_MoveBuffer.clear();
+
+		std::swap(m_Pairs, m_PairScratch);
+	}
+
+	const std::vector<BodyPair>& DynamicAabbTree::GetPairs() const
+	{
+		return m_Pairs;
+	}
+
+	int32_t DynamicAabbTree::GetHeight() const
+	{
+		return m_Root == NULL_NODE ? 0 : m_Nodes[m_Root].Height;
+	}
+
+	void DynamicAabbTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NULL_NODE;
+		m_FreeList = NULL_NODE;
+		m_BodyNodes.clear();
+		m_MoveBuffer.clear();
+		m_Moved.clear();
+		m_Pairs.clear();
+	}
+
+	int32_t DynamicAabbTree::AllocateNode()
+	{
+		if (m_FreeList == NULL_NODE)
+		{
+			m_Nodes.emplace_back();
+			return (int32_t)m_Nodes.size() - 1;
+		}
+
+		const int32_t node = m_FreeList;
+		m_FreeList = m_Nodes[node].Parent;
+		m_Nodes[node] = Node{};
+		return node;
+	}
+
+	void DynamicAabbTree::FreeNode(const int32_t node)
+	{
+		m_Nodes[node].Parent = m_FreeList;
+		m_Nodes[node].Height = -1;
+		m_FreeList = node;
+	}
+
+	void DynamicAabbTree::InsertLeaf(const int32_t leaf)
+	{
+		if (m_Root == NULL_NODE)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = NULL_NODE;
+			return;
+		}
+
+		// Find the best sibling with the surface area heuristic
+		const Aabb leafBounds = m_Nodes[leaf].Bounds;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+			const float area = node.Bounds.SurfaceArea();
+			const float combinedArea = node.Bounds.Merged(leafBounds).SurfaceArea();
+
+			// Cost of creating a new parent for this node and the leaf
+			const float cost = 2.0f * combinedArea;
+			// Minimum cost of pushing the leaf further down the tree
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto childCost = [&](const int32_t child)
+			{
+				const Aabb merged = leafBounds.Merged(m_Nodes[child].Bounds);
+				if (m_Nodes[child].IsLeaf())
+				{
+					return merged.SurfaceArea() + inheritanceCost;
+				}
+				return merged.SurfaceArea() - m_Nodes[child].Bounds.SurfaceArea() + inheritanceCost;
+			};
+
+			const float cost1 = childCost(node.Child1);
+			const float cost2 = childCost(node.Child2);
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		const int32_t sibling = index;
+		const int32_t oldParent = m_Nodes[sibling].Parent;
+		const int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Bounds = leafBounds.Merged(m_Nodes[sibling].Bounds);
+		m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+		m_Nodes[newParent].Child1 = sibling;
+		m_Nodes[newParent].Child2 = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if (oldParent == NULL_NODE)
+		{
+			m_Root = newParent;
+		}
+		else if (m_Nodes[oldParent].Child1 == sibling)
+		{
+			m_Nodes[oldParent].Child1 = newParent;
+		}
+		else
+		{
+			m_Nodes[oldParent].Child2 = newParent;
+		}
+
+		RefitAncestors(m_Nodes[leaf].Parent);
+	}
+
+	void DynamicAabbTree::RemoveLeaf(const int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NULL_NODE;
+			return;
+		}
+
+		const int32_t parent = m_Nodes[leaf].Parent;
+		const int32_t grandParent = m_Nodes[parent].Parent;
+		const int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		if (grandParent == NULL_NODE)
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NULL_NODE;
+			FreeNode(parent);
+			return;
+		}
+
+		// Replace the parent with the sibling
+		if (m_Nodes[grandParent].Child1 == parent)
+		{
+			m_Nodes[grandParent].Child1 = sibling;
+		}
+		else
+		{
+			m_Nodes[grandParent].Child2 = sibling;
+		}
+		m_Nodes[sibling].Parent = grandParent;
+		FreeNode(parent);
+
+		RefitAncestors(grandParent);
+	}
+
+	void DynamicAabbTree::RefitAncestors(int32_t node)
+	{
+		while (node != NULL_NODE)
+		{
+			node = Balance(node);
+
+			Node& current = m_Nodes[node];
+			const Node& child1 = m_Nodes[current.Child1];
+			const Node& child2 = m_Nodes[current.Child2];
+			current.Height = 1 + std::max(child1.Height, child2.Height);
+			current.Bounds = child1.Bounds.Merged(child2.Bounds);
+
+			node = current.Parent;
+		}
+	}
+
+	int32_t DynamicAabbTree::Balance(const int32_t iA)
+	{
+		// Rotates B or C up when the heights of the subtrees of A differ by more than one.
+		//  A
+		//  +-- B
+		//  |   +-- D
+		//  |   +-- E
+		//  +-- C
+		//      +-- F
+		//      +-- G
+		Node& A = m_Nodes[iA];
+		if (A.IsLeaf() || A.Height < 2)
+		{
+			return iA;
+		}
+
+		const int32_t iB = A.Child1;
+		const int32_t iC = A.Child2;
+		Node& B = m_Nodes[iB];
+		Node& C = m_Nodes[iC];
+
+		const int32_t balance = C.Height - B.Height;
+
+		auto rotateUp = [&](const int32_t iUp, const int32_t iOther, const bool upIsChild2)
+		{
+			Node& up = m_Nodes[iUp];
+			const int32_t iF = up.Child1;
+			const int32_t iG = up.Child2;
+			Node& F = m_Nodes[iF];
+			Node& G = m_Nodes[iG];
+			Node& other = m_Nodes[iOther];
+
+			// Swap A and up
+			up.Child1 = iA;
+			up.Parent = A.Parent;
+			A.Parent = iUp;
+
+			if (up.Parent != NULL_NODE)
+			{
+				if (m_Nodes[up.Parent].Child1 == iA)
+				{
+					m_Nodes[up.Parent].Child1 = iUp;
+				}
+				else
+				{
+					m_Nodes[up.Parent].Child2 = iUp;
+				}
+			}
+			else
+			{
+				m_Root = iUp;
+			}
+
+			// The taller child of up stays with it, the other one replaces up below A.
+			const bool keepF = F.Height > G.Height;
+			const int32_t iKeep = keepF ? iF : iG;
+			const int32_t iMove = keepF ? iG : iF;
+			Node& keep = m_Nodes[iKeep];
+			Node& move = m_Nodes[iMove];
+
+			up.Child2 = iKeep;
+			if (upIsChild2)
+			{
+				A.Child2 = iMove;
+			}
+			else
+			{
+				A.Child1 = iMove;
+			}
+			move.Parent = iA;
+
+			A.Bounds = other.Bounds.Merged(move.Bounds);
+			up.Bounds = A.Bounds.Merged(keep.Bounds);
+			A.Height = 1 + std::max(other.Height, move.Height);
+			up.Height = 1 + std::max(A.Height, keep.Height);
+		};
+
+		if (balance > 1)
+		{
+			rotateUp(iC, iB, true);
+			return iC;
+		}
+
+		if (balance < -1)
+		{
+			rotateUp(iB, iC, false);
+			return iB;
+		}
+
+		return iA;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,224 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "Collision/Aabb.h"
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Incremental bounding volume tree keyed by body handle, after the dynamic tree of Box2D.
+	* Leaves store fattened bounds, a body is only re-inserted once it leaves its fat box,
+	* so bodies that barely move (or are static) cost nothing to update.
+	* Nodes are pooled in one array with a free list, and rotations keep the tree balanced.
+	*/
+	class DynamicAabbTree
+	{
+	public:
+		static constexpr int32_t NULL_NODE = -1;
+
+		explicit DynamicAabbTree(const float margin = 0.1f);
+
+		void Insert(BodyHandle body, const Aabb& bounds);
+		void Remove(BodyHandle body);
+		/**
+		* Moves the body to new tight bounds. Returns true when it left its fat box and was re-inserted.
+		*/
+		bool Move(BodyHandle body, const Aabb& bounds);
+		bool Contains(BodyHandle body) const;
+		const Aabb& GetFatAabb(BodyHandle body) const;
+
+		/**
+		* Synchronizes the tree with every body that has a collider.
+		* Static bodies are only inserted once, dynamic bodies are moved.
+		*/
+		void UpdateBodies(BodyStore& bodies);
+
+		/**
+		* Updates the persistent pair list. Pairs between bodies that did not leave their fat box are kept,
+		* only the re-inserted bodies are queried against the tree. Pairs of two static bodies are skipped.
+		*/
+		void UpdatePairs(const BodyStore& bodies);
+		const std::vector<BodyPair>& GetPairs() const;
+
+		/**
+		* Calls func(body) for every fat box overlapping bounds, func returns false to stop the query.
+		*/
+		template<typename TFunc>
+		void QueryOverlap(const Aabb& bounds, TFunc&& func) const;
+
+		/**
+		* Walks the fat boxes hit by the ray origin + t * direction, t in [0, maxDistance].
+		* func(body, maxDistance) returns the new max distance: the hit distance to clip the ray
+		* for a closest hit query, maxDistance to keep going or 0 to stop.
+		*/
+		template<typename TFunc>
+		void RayCast(const Eigen::Vector3f& origin, const Eigen::Vector3f& direction, float maxDistance, TFunc&& func) const;
+
+		int32_t GetHeight() const;
+		void Clear();
+
+	private:
+		struct Node
+		{
+			Aabb Bounds;
+			// Parent while in the tree, next free node while in the free list
+			int32_t Parent = NULL_NODE;
+			int32_t Child1 = NULL_NODE;
+			int32_t Child2 = NULL_NODE;
+			// Leaves have height 0, free nodes -1
+			int32_t Height = -1;
+			BodyHandle Body = INVALID_BODY_HANDLE;
+
+			bool IsLeaf() const { return Child1 == NULL_NODE; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(const int32_t node);
+
+		void InsertLeaf(const int32_t leaf);
+		void RemoveLeaf(const int32_t leaf);
+		int32_t Balance(const int32_t node);
+		void RefitAncestors(int32_t node);
+
+	private:
+		// Deep enough for any balanced tree that fits in memory
+		static constexpr int32_t STACK_SIZE = 256;
+
+		/**
+		* Traversal stack of the queries. Stays on the call stack for the first STACK_SIZE entries
+		* and spills to the heap beyond that, so a degenerate tree is still walked completely.
+		*/
+		class NodeStack
+		{
+		public:
+			void Push(const int32_t node)
+			{
+				if (m_Count < STACK_SIZE)
+				{
+					m_Nodes[m_Count++] = node;
+				}
+				else
+				{
+					m_Overflow.push_back(node);
+				}
+			}
+
+			int32_t Pop()
+			{
+				// The overflow only fills once the fixed part is full, so it holds the most recent entries.
+				if (!m_Overflow.empty())
+				{
+					const int32_t node = m_Overflow.back();
+					m_Overflow.pop_back();
+					return node;
+				}
+				return m_Nodes[--m_Count];
+			}
+
+			bool IsEmpty() const { return m_Count == 0; }
+
+		private:
+			int32_t m_Nodes[STACK_SIZE];
+			int32_t m_Count = 0;
+			std::vector<int32_t> m_Overflow;
+		};
+
+		float m_Margin;
+
+		std::vector<Node> m_Nodes;
+		int32_t m_Root = NULL_NODE;
+		int32_t m_FreeList = NULL_NODE;
+
+		// Leaf of every body, NULL_NODE for bodies not in the tree
+		std::vector<int32_t> m_BodyNodes;
+
+		// Bodies re-inserted since the last UpdatePairs
+		std::vector<BodyHandle> m_MoveBuffer;
+		std::vector<uint8_t> m_Moved;
+
+		std::vector<BodyPair> m_Pairs;
+		std::vector<BodyPair> m_PairScratch;
+	};
+
+	template<typename TFunc>
+	void DynamicAabbTree::QueryOverlap(const Aabb& bounds, TFunc&& func) const
+	{
+		NodeStack stack;
+		if (m_Root != NULL_NODE)
+		{
+			stack.Push(m_Root);
+		}
+
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_Nodes[stack.Pop()];
+			if (!node.Bounds.Overlaps(bounds))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				if (!func(node.Body))
+				{
+					return;
+				}
+			}
+			else
+			{
+				stack.Push(node.Child1);
+				stack.Push(node.Child2);
+			}
+		}
+	}
+
+	template<typename TFunc>
+	void DynamicAabbTree::RayCast(const Eigen::Vector3f& origin, const Eigen::Vector3f& direction, float maxDistance, TFunc&& func) const
+	{
+		const Eigen::Vector3f inverseDirection = direction.cwiseInverse();
+
+		// Slab test, infinities from zero direction components compare correctly.
+		auto hitDistance = [&](const Aabb& bounds)
+		{
+			const Eigen::Array3f t1 = (bounds.Min - origin).array() * inverseDirection.array();
+			const Eigen::Array3f t2 = (bounds.Max - origin).array() * inverseDirection.array();
+			const float tMin = std::max(t1.min(t2).maxCoeff(), 0.0f);
+			const float tMax = t1.max(t2).minCoeff();
+			return tMin <= tMax ? tMin : -1.0f;
+		};
+
+		NodeStack stack;
+		if (m_Root != NULL_NODE)
+		{
+			stack.Push(m_Root);
+		}
+
+		while (!stack.IsEmpty())
+		{
+			const Node& node = m_Nodes[stack.Pop()];
+			const float t = hitDistance(node.Bounds);
+			if (t < 0.0f || t > maxDistance)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				maxDistance = func(node.Body, maxDistance);
+				if (maxDistance <= 0.0f)
+				{
+					return;
+				}
+			}
+			else
+			{
+				stack.Push(node.Child1);
+				stack.Push(node.Child2);
+			}
+		}
+	}
+}
\ No newline at end of file
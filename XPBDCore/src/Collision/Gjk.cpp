@@ -0,0 +1,372 @@
+#include "Gjk.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Simulation
+{
+	namespace
+	{
+		constexpr float DEGENERATE_EPSILON = 1e-12f;
+		// Tetrahedra thinner than this fraction of their size are treated as flat
+		constexpr float FLAT_TOLERANCE = 1e-5f;
+
+		struct SubSimplex
+		{
+			uint32_t Indices[3];
+			float Weights[3];
+			uint32_t Count;
+			Eigen::Vector3f Closest;
+		};
+
+		SubSimplex SolvePoint(const GjkSimplex& simplex, const uint32_t a)
+		{
+			return SubSimplex{ { a }, { 1.0f }, 1, simplex.Vertices[a].Point };
+		}
+
+		SubSimplex SolveSegment(const GjkSimplex& simplex, const uint32_t a, const uint32_t b)
+		{
+			const Eigen::Vector3f& pa = simplex.Vertices[a].Point;
+			const Eigen::Vector3f& pb = simplex.Vertices[b].Point;
+			const Eigen::Vector3f ab = pb - pa;
+			const float lengthSq = ab.squaredNorm();
+			if (lengthSq < DEGENERATE_EPSILON)
+			{
+				return SolvePoint(simplex, a);
+			}
+
+			const float t = -pa.dot(ab) / lengthSq;
+			if (t <= 0.0f)
+			{
+				return SolvePoint(simplex, a);
+			}
+			if (t >= 1.0f)
+			{
+				return SolvePoint(simplex, b);
+			}
+			return SubSimplex{ { a, b }, { 1.0f - t, t }, 2, pa + t * ab };
+		}
+
+		SubSimplex Closer(const SubSimplex& first, const SubSimplex& second)
+		{
+			return first.Closest.squaredNorm() <= second.Closest.squaredNorm() ? first : second;
+		}
+
+		// Ericson, Real-Time Collision Detection 5.1.5, with the origin as the query point
+		SubSimplex SolveTriangle(const GjkSimplex& simplex, const uint32_t a, const uint32_t b, const uint32_t c)
+		{
+			const Eigen::Vector3f& pa = simplex.Vertices[a].Point;
+			const Eigen::Vector3f& pb = simplex.Vertices[b].Point;
+			const Eigen::Vector3f& pc = simplex.Vertices[c].Point;
+			const Eigen::Vector3f ab = pb - pa;
+			const Eigen::Vector3f ac = pc - pa;
+
+			const float d1 = -ab.dot(pa);
+			const float d2 = -ac.dot(pa);
+			if (d1 <= 0.0f && d2 <= 0.0f)
+			{
+				return SolvePoint(simplex, a);
+			}
+
+			const float d3 = -ab.dot(pb);
+			const float d4 = -ac.dot(pb);
+			if (d3 >= 0.0f && d4 <= d3)
+			{
+				return SolvePoint(simplex, b);
+			}
+
+			const float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+			{
+				return SolveSegment(simplex, a, b);
+			}
+
+			const float d5 = -ab.dot(pc);
+			const float d6 = -ac.dot(pc);
+			if (d6 >= 0.0f && d5 <= d6)
+			{
+				return SolvePoint(simplex, c);
+			}
+
+			const float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+			{
+				return SolveSegment(simplex, a, c);
+			}
+
+			const float va = d3 * d6 - d5 * d4;
+			if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+			{
+				return SolveSegment(simplex, b, c);
+			}
+
+			const float sum = va + vb + vc;
+			if (sum < DEGENERATE_EPSILON)
+			{
+				// Collinear points, the closest point lies on one of the edges.
+				return Closer(Closer(SolveSegment(simplex, a, b), SolveSegment(simplex, a, c)), SolveSegment(simplex, b, c));
+			}
+
+			const float v = vb / sum;
+			const float w = vc / sum;
+			return SubSimplex{ { a, b, c }, { 1.0f - v - w, v, w }, 3, pa + v * ab + w * ac };
+		}
+
+		/**
+		* True when the origin and d are on opposite sides of the plane through a, b and c.
+		*/
+		bool IsOriginOutsideFace(const Eigen::Vector3f& a, const Eigen::Vector3f& b, const Eigen::Vector3f& c, const Eigen::Vector3f& d)
+		{
+			const Eigen::Vector3f normal = (b - a).cross(c - a);
+			return normal.dot(-a) * normal.dot(d - a) < 0.0f;
+		}
+
+		/**
+		* Signed volume (times six) of the tetrahedron, flat is set when it is too thin to trust the orientation tests.
+		*/
+		float ComputeVolume(const Eigen::Vector3f& a, const Eigen::Vector3f& b, const Eigen::Vector3f& c, const Eigen::Vector3f& d, bool& flat)
+		{
+			const Eigen::Vector3f ab = b - a;
+			const Eigen::Vector3f ac = c - a;
+			const Eigen::Vector3f ad = d - a;
+			const float volume = ab.cross(ac).dot(ad);
+			const float size = std::max({ ab.squaredNorm(), ac.squaredNorm(), ad.squaredNorm(), (c - b).squaredNorm(), (d - b).squaredNorm(), (d - c).squaredNorm() });
+			flat = std::abs(volume) <= FLAT_TOLERANCE * size * std::sqrt(size) + DEGENERATE_EPSILON;
+			return volume;
+		}
+
+		void Reduce(GjkSimplex& simplex, const SubSimplex& solution)
+		{
+			GjkSimplex reduced;
+			reduced.Count = solution.Count;
+			for (uint32_t i = 0; i < solution.Count; ++i)
+			{
+				reduced.Vertices[i] = simplex.Vertices[solution.Indices[i]];
+				reduced.Weights[i] = solution.Weights[i];
+			}
+			simplex = reduced;
+		}
+	}
+
+	bool SolveSimplex(GjkSimplex& simplex, Eigen::Vector3f& closest)
+	{
+		SubSimplex solution;
+		switch (simplex.Count)
+		{
+		case 1:
+			solution = SolvePoint(simplex, 0);
+			break;
+		case 2:
+			solution = SolveSegment(simplex, 0, 1);
+			break;
+		case 3:
+			solution = SolveTriangle(simplex, 0, 1, 2);
+			break;
+		default:
+		{
+			const Eigen::Vector3f& a = simplex.Vertices[0].Point;
+			const Eigen::Vector3f& b = simplex.Vertices[1].Point;
+			const Eigen::Vector3f& c = simplex.Vertices[2].Point;
+			const Eigen::Vector3f& d = simplex.Vertices[3].Point;
+
+			bool flat = false;
+			ComputeVolume(a, b, c, d, flat);
+
+			// A flat tetrahedron cannot enclose the origin, its faces overlap in one plane and the closest one wins.
+			bool found = false;
+			const uint32_t faces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+			for (const auto& face : faces)
+			{
+				if (flat || IsOriginOutsideFace(simplex.Vertices[face[0]].Point, simplex.Vertices[face[1]].Point,
+					simplex.Vertices[face[2]].Point, simplex.Vertices[face[3]].Point))
+				{
+					const SubSimplex faceSolution = SolveTriangle(simplex, face[0], face[1], face[2]);
+					solution = found ? Closer(solution, faceSolution) : faceSolution;
+					found = true;
+				}
+			}
+
+			if (!found)
+			{
+				closest = Eigen::Vector3f::Zero();
+				return false;
+			}
+			break;
+		}
+		}
+
+		closest = solution.Closest;
+		Reduce(simplex, solution);
+		return true;
+	}
+
+	bool EpaPolytope::Init(const GjkSimplex& simplex)
+	{
+		m_NumVertices = 4;
+		m_NumFaces = 0;
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			m_Vertices[i] = simplex.Vertices[i];
+		}
+
+		bool flat = false;
+		const float volume = ComputeVolume(m_Vertices[0].Point, m_Vertices[1].Point, m_Vertices[2].Point, m_Vertices[3].Point, flat);
+		if (flat)
+		{
+			return false;
+		}
+
+		// Wind every face counter-clockwise seen from outside.
+		if (volume > 0.0f)
+		{
+			AddFace(0, 2, 1);
+			AddFace(0, 1, 3);
+			AddFace(0, 3, 2);
+			AddFace(1, 2, 3);
+		}
+		else
+		{
+			AddFace(0, 1, 2);
+			AddFace(0, 3, 1);
+			AddFace(0, 2, 3);
+			AddFace(1, 3, 2);
+		}
+		return true;
+	}
+
+	const EpaPolytope::Face& EpaPolytope::GetClosestFace() const
+	{
+		uint32_t closest = 0;
+		for (uint32_t i = 1; i < m_NumFaces; ++i)
+		{
+			if (m_Faces[i].Distance < m_Faces[closest].Distance)
+			{
+				closest = i;
+			}
+		}
+		return m_Faces[closest];
+	}
+
+	bool EpaPolytope::Expand(const SupportPoint& point)
+	{
+		if (m_NumVertices == MAX_VERTICES)
+		{
+			return false;
+		}
+
+		// Remove the faces the new point sees and keep the edges that border only one of them.
+		uint32_t horizon[MAX_HORIZON_EDGES][2];
+		uint32_t numHorizon = 0;
+		for (uint32_t i = 0; i < m_NumFaces;)
+		{
+			const Face& face = m_Faces[i];
+			if (face.Normal.dot(point.Point - m_Vertices[face.Vertices[0]].Point) <= 0.0f)
+			{
+				++i;
+				continue;
+			}
+
+			for (uint32_t e = 0; e < 3; ++e)
+			{
+				const uint32_t from = face.Vertices[e];
+				const uint32_t to = face.Vertices[(e + 1) % 3];
+
+				bool shared = false;
+				for (uint32_t h = 0; h < numHorizon; ++h)
+				{
+					if (horizon[h][0] == to && horizon[h][1] == from)
+					{
+						horizon[h][0] = horizon[numHorizon - 1][0];
+						horizon[h][1] = horizon[numHorizon - 1][1];
+						--numHorizon;
+						shared = true;
+						break;
+					}
+				}
+
+				if (!shared)
+				{
+					if (numHorizon == MAX_HORIZON_EDGES)
+					{
+						return false;
+					}
+					horizon[numHorizon][0] = from;
+					horizon[numHorizon][1] = to;
+					++numHorizon;
+				}
+			}
+
+			m_Faces[i] = m_Faces[--m_NumFaces];
+		}
+
+		if (numHorizon == 0 || m_NumFaces + numHorizon > MAX_FACES)
+		{
+			return false;
+		}
+
+		const uint32_t newVertex = m_NumVertices++;
+		m_Vertices[newVertex] = point;
+		for (uint32_t h = 0; h < numHorizon; ++h)
+		{
+			AddFace(horizon[h][0], horizon[h][1], newVertex);
+		}
+		return true;
+	}
+
+	void EpaPolytope::GetContact(Eigen::Vector3f& normal, float& depth, Eigen::Vector3f& pointA, Eigen::Vector3f& pointB) const
+	{
+		const Face& face = GetClosestFace();
+		normal = face.Normal;
+		depth = face.Distance;
+
+		// Barycentric coordinates of the origin projected on the face
+		const SupportPoint& a = m_Vertices[face.Vertices[0]];
+		const SupportPoint& b = m_Vertices[face.Vertices[1]];
+		const SupportPoint& c = m_Vertices[face.Vertices[2]];
+		const Eigen::Vector3f projected = face.Distance * face.Normal;
+
+		const Eigen::Vector3f v0 = b.Point - a.Point;
+		const Eigen::Vector3f v1 = c.Point - a.Point;
+		const Eigen::Vector3f v2 = projected - a.Point;
+		const float d00 = v0.dot(v0);
+		const float d01 = v0.dot(v1);
+		const float d11 = v1.dot(v1);
+		const float d20 = v2.dot(v0);
+		const float d21 = v2.dot(v1);
+		const float denominator = d00 * d11 - d01 * d01;
+
+		float v = 0.0f;
+		float w = 0.0f;
+		if (std::abs(denominator) > DEGENERATE_EPSILON)
+		{
+			v = (d11 * d20 - d01 * d21) / denominator;
+			w = (d00 * d21 - d01 * d20) / denominator;
+		}
+		const float u = 1.0f - v - w;
+
+		pointA = u * a.PointA + v * b.PointA + w * c.PointA;
+		pointB = u * a.PointB + v * b.PointB + w * c.PointB;
+	}
+
+	void EpaPolytope::AddFace(const uint32_t a, const uint32_t b, const uint32_t c)
+	{
+		Face& face = m_Faces[m_NumFaces++];
+		face.Vertices[0] = a;
+		face.Vertices[1] = b;
+		face.Vertices[2] = c;
+
+		const Eigen::Vector3f normal = (m_Vertices[b].Point - m_Vertices[a].Point).cross(m_Vertices[c].Point - m_Vertices[a].Point);
+		const float length = normal.norm();
+		if (length < DEGENERATE_EPSILON)
+		{
+			// Sliver faces keep the polytope closed but are never picked as the closest face.
+			face.Normal = Eigen::Vector3f::UnitX();
+			face.Distance = FLT_MAX;
+			return;
+		}
+
+		face.Normal = normal / length;
+		face.Distance = face.Normal.dot(m_Vertices[a].Point);
+	}
+}
\ No newline at end of file
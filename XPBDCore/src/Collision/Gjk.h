@@ -0,0 +1,370 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "Collision/ContactManifold.h"
+#include "Collision/ConvexShapes.h"
+
+namespace Simulation
+{
+	/**
+	* Vertex of the Minkowski difference A - B and the shape points that produced it.
+	*/
+	struct SupportPoint
+	{
+		Eigen::Vector3f Point = Eigen::Vector3f::Zero();
+		Eigen::Vector3f PointA = Eigen::Vector3f::Zero();
+		Eigen::Vector3f PointB = Eigen::Vector3f::Zero();
+		// Search direction the point was found with, kept so the simplex can be rebuilt next frame
+		Eigen::Vector3f Direction = Eigen::Vector3f::Zero();
+	};
+
+	struct GjkSimplex
+	{
+		std::array<SupportPoint, 4> Vertices;
+		// Barycentric weights of the point closest to the origin
+		std::array<float, 4> Weights = {};
+		uint32_t Count = 0;
+	};
+
+	/**
+	* Search directions of the last simplex of a pair. Re-evaluating them on the moved shapes
+	* starts GJK next to the answer, so coherent frames converge in one or two iterations.
+	*/
+	struct GjkCache
+	{
+		std::array<Eigen::Vector3f, 4> Directions;
+		uint32_t Count = 0;
+	};
+
+	struct GjkResult
+	{
+		bool Intersecting = false;
+		// Distance between the shape cores and the closest points on them, valid when not intersecting
+		float Distance = 0.0f;
+		Eigen::Vector3f PointA = Eigen::Vector3f::Zero();
+		Eigen::Vector3f PointB = Eigen::Vector3f::Zero();
+		uint32_t Iterations = 0;
+		GjkSimplex Simplex;
+	};
+
+	/**
+	* Reduces the simplex to the smallest sub-simplex that contains the point closest to the origin
+	* and stores that point in closest. Returns false when a tetrahedron encloses the origin.
+	*/
+	bool SolveSimplex(GjkSimplex& simplex, Eigen::Vector3f& closest);
+
+	/**
+	* Expanding polytope of EPA. The support mapping stays in the GJK templates,
+	* this class only maintains the faces, so it is shared by every pair of shape types.
+	*/
+	class EpaPolytope
+	{
+	public:
+		struct Face
+		{
+			uint32_t Vertices[3];
+			Eigen::Vector3f Normal;
+			float Distance;
+		};
+
+		/**
+		* Starts from a tetrahedron around the origin. Returns false if it is flat.
+		*/
+		bool Init(const GjkSimplex& simplex);
+
+		const Face& GetClosestFace() const;
+
+		/**
+		* Replaces the faces that see point with a fan around it. Returns false when the polytope is full.
+		*/
+		bool Expand(const SupportPoint& point);
+
+		/**
+		* Contact of the closest face, normal points from A towards B.
+		*/
+		void GetContact(Eigen::Vector3f& normal, float& depth, Eigen::Vector3f& pointA, Eigen::Vector3f& pointB) const;
+
+	private:
+		static constexpr uint32_t MAX_VERTICES = 64;
+		static constexpr uint32_t MAX_FACES = 128;
+		static constexpr uint32_t MAX_HORIZON_EDGES = 64;
+
+		void AddFace(const uint32_t a, const uint32_t b, const uint32_t c);
+
+	private:
+		std::array<SupportPoint, MAX_VERTICES> m_Vertices;
+		uint32_t m_NumVertices = 0;
+		std::array<Face, MAX_FACES> m_Faces;
+		uint32_t m_NumFaces = 0;
+	};
+
+	template<typename TShapeA, typename TShapeB>
+	SupportPoint ComputeCoreSupport(const TShapeA& a, const TShapeB& b, const Eigen::Vector3f& direction)
+	{
+		SupportPoint support;
+		support.PointA = SupportCore(a, direction);
+		support.PointB = SupportCore(b, -direction);
+		support.Point = support.PointA - support.PointB;
+		support.Direction = direction;
+		return support;
+	}
+
+	template<typename TShapeA, typename TShapeB>
+	SupportPoint ComputeSupport(const TShapeA& a, const TShapeB& b, const Eigen::Vector3f& direction)
+	{
+		const Eigen::Vector3f unitDirection = direction.normalized();
+		SupportPoint support;
+		support.PointA = SupportCore(a, direction) + GetMargin(a) * unitDirection;
+		support.PointB = SupportCore(b, -direction) - GetMargin(b) * unitDirection;
+		support.Point = support.PointA - support.PointB;
+		support.Direction = direction;
+		return support;
+	}
+
+	namespace Detail
+	{
+		constexpr uint32_t GJK_MAX_ITERATIONS = 32;
+		constexpr uint32_t EPA_MAX_ITERATIONS = 64;
+		constexpr float GJK_RELATIVE_TOLERANCE = 1e-6f;
+		constexpr float EPA_TOLERANCE = 1e-4f;
+		// Core distances below this are treated as touching cores and resolved with EPA
+		constexpr float CORE_DISTANCE_EPSILON = 1e-4f;
+		constexpr float DUPLICATE_EPSILON = 1e-10f;
+
+		inline bool ContainsPoint(const GjkSimplex& simplex, const Eigen::Vector3f& point)
+		{
+			for (uint32_t i = 0; i < simplex.Count; ++i)
+			{
+				if ((simplex.Vertices[i].Point - point).squaredNorm() < DUPLICATE_EPSILON)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		* Adds support points until the simplex is a tetrahedron, EPA needs a volume to start from.
+		*/
+		template<typename TShapeA, typename TShapeB>
+		bool CompleteSimplex(const TShapeA& a, const TShapeB& b, GjkSimplex& simplex)
+		{
+			const Eigen::Vector3f axes[3] = { Eigen::Vector3f::UnitX(), Eigen::Vector3f::UnitY(), Eigen::Vector3f::UnitZ() };
+			auto tryAdd = [&](const Eigen::Vector3f& direction, auto isValid)
+			{
+				for (const float sign : { 1.0f, -1.0f })
+				{
+					const SupportPoint support = ComputeSupport(a, b, sign * direction);
+					if (isValid(support.Point))
+					{
+						simplex.Vertices[simplex.Count++] = support;
+						return true;
+					}
+				}
+				return false;
+			};
+
+			if (simplex.Count == 0)
+			{
+				simplex.Vertices[simplex.Count++] = ComputeSupport(a, b, Eigen::Vector3f::UnitX());
+			}
+
+			if (simplex.Count == 1)
+			{
+				const Eigen::Vector3f p0 = simplex.Vertices[0].Point;
+				for (uint32_t i = 0; i < 3 && simplex.Count == 1; ++i)
+				{
+					tryAdd(axes[i], [&](const Eigen::Vector3f& p) { return (p - p0).squaredNorm() > DUPLICATE_EPSILON; });
+				}
+			}
+
+			if (simplex.Count == 2)
+			{
+				const Eigen::Vector3f p0 = simplex.Vertices[0].Point;
+				const Eigen::Vector3f edge = simplex.Vertices[1].Point - p0;
+				for (uint32_t i = 0; i < 3 && simplex.Count == 2; ++i)
+				{
+					const Eigen::Vector3f direction = edge.cross(axes[i]);
+					if (direction.squaredNorm() > DUPLICATE_EPSILON)
+					{
+						tryAdd(direction, [&](const Eigen::Vector3f& p) { return edge.cross(p - p0).squaredNorm() > DUPLICATE_EPSILON; });
+					}
+				}
+			}
+
+			if (simplex.Count == 3)
+			{
+				const Eigen::Vector3f p0 = simplex.Vertices[0].Point;
+				const Eigen::Vector3f normal = (simplex.Vertices[1].Point - p0).cross(simplex.Vertices[2].Point - p0);
+				tryAdd(normal, [&](const Eigen::Vector3f& p) { return std::abs(normal.dot(p - p0)) > DUPLICATE_EPSILON; });
+			}
+
+			return simplex.Count == 4;
+		}
+	}
+
+	/**
+	* Distance between the cores of two convex shapes (margins are not included).
+	* Pass the cache of the pair to warm start from the simplex of the previous query, it is updated on return.
+	*/
+	template<typename TShapeA, typename TShapeB>
+	GjkResult GjkDistance(const TShapeA& a, const TShapeB& b, GjkCache* cache = nullptr)
+	{
+		using namespace Detail;
+
+		GjkResult result;
+		GjkSimplex& simplex = result.Simplex;
+
+		if (cache != nullptr)
+		{
+			for (uint32_t i = 0; i < cache->Count; ++i)
+			{
+				const SupportPoint support = ComputeCoreSupport(a, b, cache->Directions[i]);
+				if (!ContainsPoint(simplex, support.Point))
+				{
+					simplex.Vertices[simplex.Count++] = support;
+				}
+			}
+		}
+
+		if (simplex.Count == 0)
+		{
+			Eigen::Vector3f direction = GetCenter(b) - GetCenter(a);
+			if (direction.squaredNorm() < DUPLICATE_EPSILON)
+			{
+				direction = Eigen::Vector3f::UnitX();
+			}
+			simplex.Vertices[simplex.Count++] = ComputeCoreSupport(a, b, direction);
+		}
+
+		Eigen::Vector3f closest = Eigen::Vector3f::Zero();
+		while (true)
+		{
+			if (!SolveSimplex(simplex, closest) || closest.squaredNorm() < DUPLICATE_EPSILON)
+			{
+				result.Intersecting = true;
+				break;
+			}
+
+			if (result.Iterations == GJK_MAX_ITERATIONS)
+			{
+				break;
+			}
+			++result.Iterations;
+
+			// Stop once the new support point does not get closer to the origin.
+			const SupportPoint support = ComputeCoreSupport(a, b, -closest);
+			const float closestSq = closest.squaredNorm();
+			if (closestSq - closest.dot(support.Point) <= GJK_RELATIVE_TOLERANCE * closestSq || ContainsPoint(simplex, support.Point))
+			{
+				break;
+			}
+			simplex.Vertices[simplex.Count++] = support;
+		}
+
+		if (!result.Intersecting)
+		{
+			result.Distance = closest.norm();
+			for (uint32_t i = 0; i < simplex.Count; ++i)
+			{
+				result.PointA += simplex.Weights[i] * simplex.Vertices[i].PointA;
+				result.PointB += simplex.Weights[i] * simplex.Vertices[i].PointB;
+			}
+		}
+
+		if (cache != nullptr)
+		{
+			cache->Count = simplex.Count;
+			for (uint32_t i = 0; i < simplex.Count; ++i)
+			{
+				cache->Directions[i] = simplex.Vertices[i].Direction;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	* Penetration of two intersecting shapes (margins included), starting from the final GJK simplex.
+	* Returns false when no polytope could be built, which only happens for shapes that barely touch.
+	*/
+	template<typename TShapeA, typename TShapeB>
+	bool EpaPenetration(const TShapeA& a, const TShapeB& b, GjkSimplex simplex,
+		Eigen::Vector3f& normal, float& depth, Eigen::Vector3f& pointA, Eigen::Vector3f& pointB)
+	{
+		using namespace Detail;
+
+		if (!CompleteSimplex(a, b, simplex))
+		{
+			return false;
+		}
+
+		EpaPolytope polytope;
+		if (!polytope.Init(simplex))
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < EPA_MAX_ITERATIONS; ++i)
+		{
+			const EpaPolytope::Face& face = polytope.GetClosestFace();
+			const SupportPoint support = ComputeSupport(a, b, face.Normal);
+			if (face.Normal.dot(support.Point) - face.Distance < EPA_TOLERANCE || !polytope.Expand(support))
+			{
+				break;
+			}
+		}
+
+		polytope.GetContact(normal, depth, pointA, pointB);
+		return true;
+	}
+
+	/**
+	* Single point contact between two convex shapes.
+	* Separated cores only need GJK, the margins then decide about the contact. Overlapping cores go through EPA.
+	* Fills the normal and points of the manifold but not the bodies, returns false when the shapes are separated.
+	*/
+	template<typename TShapeA, typename TShapeB>
+	bool CollideConvex(const TShapeA& a, const TShapeB& b, ContactManifold& manifold, GjkCache* cache = nullptr)
+	{
+		using namespace Detail;
+
+		manifold.NumPoints = 0;
+
+		const GjkResult gjk = GjkDistance(a, b, cache);
+		const float marginA = GetMargin(a);
+		const float marginB = GetMargin(b);
+
+		ContactPoint& contact = manifold.Points[0];
+		if (!gjk.Intersecting && gjk.Distance > CORE_DISTANCE_EPSILON)
+		{
+			if (gjk.Distance >= marginA + marginB)
+			{
+				return false;
+			}
+
+			manifold.Normal = (gjk.PointB - gjk.PointA) / gjk.Distance;
+			contact.PointOnBody1 = gjk.PointA + marginA * manifold.Normal;
+			contact.PointOnBody2 = gjk.PointB - marginB * manifold.Normal;
+			contact.Depth = marginA + marginB - gjk.Distance;
+		}
+		else
+		{
+			Eigen::Vector3f normal;
+			float depth;
+			// Cores closer than the epsilon can still be apart, EPA then reports a negative depth.
+			if (!EpaPenetration(a, b, gjk.Simplex, normal, depth, contact.PointOnBody1, contact.PointOnBody2) || depth <= 0.0f)
+			{
+				return false;
+			}
+			manifold.Normal = normal;
+			contact.Depth = depth;
+		}
+
+		contact.FeatureId = 0;
+		manifold.NumPoints = 1;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "LinearBvh.h"
+#include "Simulation/JobSystem.h"
+
+#include <cassert>
+#include <limits>
+
+namespace Simulation
+{
+	namespace
+	{
+		constexpr uint32_t RADIX_BITS = 8;
+		constexpr uint32_t RADIX_SIZE = 1u << RADIX_BITS;
+		// 30 bit codes, the last pass only sorts 6 bits
+		constexpr uint32_t RADIX_PASSES = 4;
+		constexpr uint32_t MIN_CHUNK_SIZE = 4096;
+		// Internal node not reached by any child yet
+		constexpr uint32_t NO_BOUND = UINT32_MAX;
+
+		// Spreads the low 10 bits of v so there are two zero bits between each of them.
+		uint32_t ExpandBits(uint32_t v)
+		{
+			v = (v * 0x00010001u) & 0xFF0000FFu;
+			v = (v * 0x00000101u) & 0x0F00F00Fu;
+			v = (v * 0x00000011u) & 0xC30C30C3u;
+			v = (v * 0x00000005u) & 0x49249249u;
+			return v;
+		}
+
+		uint32_t MortonCode(const Eigen::Vector3f& normalized)
+		{
+			const Eigen::Vector3f scaled = (normalized * 1024.0f).cwiseMax(0.0f).cwiseMin(1023.0f);
+			return (ExpandBits((uint32_t)scaled.x()) << 2) | (ExpandBits((uint32_t)scaled.y()) << 1) | ExpandBits((uint32_t)scaled.z());
+		}
+
+		Aabb EmptyAabb()
+		{
+			const float max = std::numeric_limits<float>::max();
+			return Aabb{ Eigen::Vector3f::Constant(max), Eigen::Vector3f::Constant(-max) };
+		}
+	}
+
+	void LinearBvh::Build(BodyStore& bodies)
+	{
+		m_BodyHandles.clear();
+		for (BodyHandle body = 0; body < bodies.Size(); ++body)
+		{
+			if (bodies.Colliders[body].Type != ColliderType::None)
+			{
+				m_BodyHandles.push_back(body);
+			}
+		}
+
+		const uint32_t count = (uint32_t)m_BodyHandles.size();
+		m_BodyBounds.resize(count);
+		ParallelFor(0, count, [&](const uint32_t i)
+		{
+			m_BodyBounds[i] = ComputeBodyAabb(bodies, m_BodyHandles[i]);
+		}, 1024);
+
+		Build(m_BodyBounds.data(), m_BodyHandles.data(), count);
+	}
+
+	void LinearBvh::Build(const Aabb* bounds, const BodyHandle* handles, const uint32_t count)
+	{
+		m_NumLeaves = count;
+		m_Root = 0;
+		if (count == 0)
+		{
+			return;
+		}
+
+		m_LeafBounds.resize(count);
+		m_LeafBodies.resize(count);
+		m_Nodes.resize(count - 1);
+
+		ComputeMortonCodes(bounds);
+		SortMortonCodes();
+
+		ParallelFor(0, count, [&](const uint32_t leaf)
+		{
+			const uint32_t source = m_Order[leaf];
+			m_LeafBounds[leaf] = bounds[source];
+			m_LeafBodies[leaf] = handles[source];
+		}, 1024);
+
+		if (count == 1)
+		{
+			m_Root = LEAF_BIT;
+			return;
+		}
+
+		EmitHierarchy();
+	}
+
+	void LinearBvh::FindPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) const
+	{
+		pairs.clear();
+		for (uint32_t leaf = 0; leaf < m_NumLeaves; ++leaf)
+		{
+			const BodyHandle body = m_LeafBodies[leaf];
+			const bool isStatic = bodies.IsStatic(body);
+			QueryOverlap(m_LeafBounds[leaf], [&](const BodyHandle other)
+			{
+				// Every pair is found from both sides, keep the one seen from the lower handle.
+				if (other > body && !(isStatic && bodies.IsStatic(other)))
+				{
+					pairs.push_back(BodyPair{ body, other });
+				}
+				return true;
+			});
+		}
+	}
+
+	uint32_t LinearBvh::GetNumLeaves() const
+	{
+		return m_NumLeaves;
+	}
+
+	void LinearBvh::ComputeMortonCodes(const Aabb* bounds)
+	{
+		const uint32_t count = m_NumLeaves;
+		const uint32_t numChunks = std::max(1u, std::min((count + MIN_CHUNK_SIZE - 1) / MIN_CHUNK_SIZE, 4 * (JobSystem::Get().GetNumWorkers() + 1)));
+		const uint32_t chunkSize = (count + numChunks - 1) / numChunks;
+
+		// Bounds of the centroids, reduced per chunk and then serially over the chunks.
+		m_ChunkBounds.resize(numChunks);
+		ParallelFor(0, numChunks, [&](const uint32_t chunk)
+		{
+			Aabb chunkBounds = EmptyAabb();
+			const uint32_t end = std::min(count, (chunk + 1) * chunkSize);
+			for (uint32_t i = chunk * chunkSize; i < end; ++i)
+			{
+				const Eigen::Vector3f center = bounds[i].Center();
+				chunkBounds.Min = chunkBounds.Min.cwiseMin(center);
+				chunkBounds.Max = chunkBounds.Max.cwiseMax(center);
+			}
+			m_ChunkBounds[chunk] = chunkBounds;
+		}, 1);
+
+		Aabb sceneBounds = EmptyAabb();
+		for (const Aabb& chunkBounds : m_ChunkBounds)
+		{
+			sceneBounds = sceneBounds.Merged(chunkBounds);
+		}
+
+		const Eigen::Vector3f extent = sceneBounds.Max - sceneBounds.Min;
+		const Eigen::Vector3f inverseExtent = extent.unaryExpr([](const float e) { return e > 0.0f ? 1.0f / e : 0.0f; });
+
+		m_Codes.resize(count);
+		m_Order.resize(count);
+		ParallelFor(0, count, [&](const uint32_t i)
+		{
+			m_Codes[i] = MortonCode((bounds[i].Center() - sceneBounds.Min).cwiseProduct(inverseExtent));
+			m_Order[i] = i;
+		}, 1024);
+	}
+
+	void LinearBvh::SortMortonCodes()
+	{
+		// Least significant digit radix sort. Every chunk builds its own histogram,
+		// so each chunk knows where to scatter its keys and the passes stay stable.
+		const uint32_t count = m_NumLeaves;
+		const uint32_t numChunks = std::max(1u, std::min((count + MIN_CHUNK_SIZE - 1) / MIN_CHUNK_SIZE, 4 * (JobSystem::Get().GetNumWorkers() + 1)));
+		const uint32_t chunkSize = (count + numChunks - 1) / numChunks;
+
+		m_CodesScratch.resize(count);
+		m_OrderScratch.resize(count);
+		m_Histograms.resize(numChunks * RADIX_SIZE);
+
+		for (uint32_t pass = 0; pass < RADIX_PASSES; ++pass)
+		{
+			const uint32_t shift = pass * RADIX_BITS;
+
+			ParallelFor(0, numChunks, [&](const uint32_t chunk)
+			{
+				uint32_t* histogram = &m_Histograms[chunk * RADIX_SIZE];
+				std::fill(histogram, histogram + RADIX_SIZE, 0u);
+
+				const uint32_t end = std::min(count, (chunk + 1) * chunkSize);
+				for (uint32_t i = chunk * chunkSize; i < end; ++i)
+				{
+					++histogram[(m_Codes[i] >> shift) & (RADIX_SIZE - 1)];
+				}
+			}, 1);
+
+			// Exclusive prefix sum over (digit, chunk), the histograms become the write cursors.
+			uint32_t offset = 0;
+			for (uint32_t digit = 0; digit < RADIX_SIZE; ++digit)
+			{
+				for (uint32_t chunk = 0; chunk < numChunks; ++chunk)
+				{
+					uint32_t& slot = m_Histograms[chunk * RADIX_SIZE + digit];
+					const uint32_t digitCount = slot;
+					slot = offset;
+					offset += digitCount;
+				}
+			}
+
+			ParallelFor(0, numChunks, [&](const uint32_t chunk)
+			{
+				uint32_t* cursors = &m_Histograms[chunk * RADIX_SIZE];
+
+				const uint32_t end = std::min(count, (chunk + 1) * chunkSize);
+				for (uint32_t i = chunk * chunkSize; i < end; ++i)
+				{
+					const uint32_t slot = cursors[(m_Codes[i] >> shift) & (RADIX_SIZE - 1)]++;
+					m_CodesScratch[slot] = m_Codes[i];
+					m_OrderScratch[slot] = m_Order[i];
+				}
+			}, 1);
+
+			std::swap(m_Codes, m_CodesScratch);
+			std::swap(m_Order, m_OrderScratch);
+		}
+	}
+
+	void LinearBvh::EmitHierarchy()
+	{
+		const uint32_t count = m_NumLeaves;
+		const uint32_t numInternal = count - 1;
+
+		if (m_OtherBoundsCapacity < numInternal)
+		{
+			m_OtherBounds.reset(new std::atomic<uint32_t>[numInternal]);
+			m_OtherBoundsCapacity = numInternal;
+		}
+
+		ParallelFor(0, numInternal, [this](const uint32_t node)
+		{
+			m_OtherBounds[node].store(NO_BOUND, std::memory_order_relaxed);
+		}, 4096);
+
+		// Split metric between leaves i and i + 1. The leaf index breaks ties between equal codes.
+		auto delta = [this](const uint32_t i)
+		{
+			const uint64_t a = ((uint64_t)m_Codes[i] << 32) | i;
+			const uint64_t b = ((uint64_t)m_Codes[i + 1] << 32) | (i + 1);
+			return a ^ b;
+		};
+
+		// Apetrei 2014: each leaf walks up towards the root. The node covering leaves [left, right]
+		// has its parent at right (when the split to its right is lower than the one to its left) or left - 1.
+		// The first thread to reach a parent leaves its range bound and stops, the second one finishes the parent.
+		ParallelFor(0, count, [&](const uint32_t leaf)
+		{
+			uint32_t left = leaf;
+			uint32_t right = leaf;
+			uint32_t current = leaf | LEAF_BIT;
+
+			while (true)
+			{
+				if (left == 0 && right == numInternal)
+				{
+					m_Root = current;
+					return;
+				}
+
+				uint32_t parent;
+				uint32_t previous;
+				if (left == 0 || (right != numInternal && delta(right) < delta(left - 1)))
+				{
+					parent = right;
+					m_Nodes[parent].Left = current;
+					previous = m_OtherBounds[parent].exchange(left, std::memory_order_acq_rel);
+					if (previous == NO_BOUND)
+					{
+						return;
+					}
+					right = previous;
+				}
+				else
+				{
+					parent = left - 1;
+					m_Nodes[parent].Right = current;
+					previous = m_OtherBounds[parent].exchange(right, std::memory_order_acq_rel);
+					if (previous == NO_BOUND)
+					{
+						return;
+					}
+					left = previous;
+				}
+
+				Node& node = m_Nodes[parent];
+				node.Bounds = GetBounds(node.Left).Merged(GetBounds(node.Right));
+				current = parent;
+			}
+		}, 256);
+	}
+}
\ No newline at end of file
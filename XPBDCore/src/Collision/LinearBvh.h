@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "Collision/Aabb.h"
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Bounding volume hierarchy rebuilt from scratch every update, for scenes where most bodies move.
+	* Bodies are ordered along a 30 bit Morton curve with a parallel radix sort, then the hierarchy
+	* and its bounds are emitted in a single parallel bottom-up pass (Apetrei 2014).
+	* Every buffer is reused, so rebuilding does not allocate once the body count stopped growing.
+	*/
+	class LinearBvh
+	{
+	public:
+		/**
+		* Rebuilds the hierarchy over every body that has a collider.
+		*/
+		void Build(BodyStore& bodies);
+
+		/**
+		* Rebuilds the hierarchy over count boxes, leaf i reports body handles[i].
+		*/
+		void Build(const Aabb* bounds, const BodyHandle* handles, const uint32_t count);
+
+		/**
+		* Calls func(body) for every leaf overlapping bounds, func returns false to stop the query.
+		*/
+		template<typename TFunc>
+		void QueryOverlap(const Aabb& bounds, TFunc&& func) const;
+
+		/**
+		* Same contract as DynamicAabbTree::RayCast.
+		*/
+		template<typename TFunc>
+		void RayCast(const Eigen::Vector3f& origin, const Eigen::Vector3f& direction, float maxDistance, TFunc&& func) const;
+
+		/**
+		* Overlapping leaf pairs, pairs of two static bodies are skipped.
+		*/
+		void FindPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs) const;
+
+		uint32_t GetNumLeaves() const;
+
+	private:
+		static constexpr uint32_t LEAF_BIT = 0x80000000u;
+		static constexpr int32_t STACK_SIZE = 256;
+
+		struct Node
+		{
+			Aabb Bounds;
+			// Internal node index, or leaf index | LEAF_BIT
+			uint32_t Left = 0;
+			uint32_t Right = 0;
+		};
+
+		void ComputeMortonCodes(const Aabb* bounds);
+		void SortMortonCodes();
+		void EmitHierarchy();
+
+		const Aabb& GetBounds(const uint32_t child) const;
+
+	private:
+		uint32_t m_NumLeaves = 0;
+		uint32_t m_Root = 0;
+
+		// Leaves in Morton order
+		std::vector<Aabb> m_LeafBounds;
+		std::vector<BodyHandle> m_LeafBodies;
+		// m_NumLeaves - 1 internal nodes, node i splits the leaves between i and i + 1
+		std::vector<Node> m_Nodes;
+
+		std::vector<uint32_t> m_Codes;
+		std::vector<uint32_t> m_CodesScratch;
+		std::vector<uint32_t> m_Order;
+		std::vector<uint32_t> m_OrderScratch;
+		std::vector<uint32_t> m_Histograms;
+		std::vector<Aabb> m_ChunkBounds;
+
+		// Range bound left by the first child to reach each internal node
+		std::unique_ptr<std::atomic<uint32_t>[]> m_OtherBounds;
+		uint32_t m_OtherBoundsCapacity = 0;
+
+		// Scratch for Build(BodyStore&)
+		std::vector<Aabb> m_BodyBounds;
+		std::vector<BodyHandle> m_BodyHandles;
+	};
+
+	template<typename TFunc>
+	void LinearBvh::QueryOverlap(const Aabb& bounds, TFunc&& func) const
+	{
+		if (m_NumLeaves == 0)
+		{
+			return;
+		}
+
+		uint32_t stack[STACK_SIZE];
+		int32_t count = 0;
+		stack[count++] = m_Root;
+
+		while (count > 0)
+		{
+			const uint32_t node = stack[--count];
+			if (!GetBounds(node).Overlaps(bounds))
+			{
+				continue;
+			}
+
+			if (node & LEAF_BIT)
+			{
+				if (!func(m_LeafBodies[node & ~LEAF_BIT]))
+				{
+					return;
+				}
+			}
+			else if (count + 2 <= STACK_SIZE)
+			{
+				stack[count++] = m_Nodes[node].Left;
+				stack[count++] = m_Nodes[node].Right;
+			}
+		}
+	}
+
+	template<typename TFunc>
+	void LinearBvh::RayCast(const Eigen::Vector3f& origin, const Eigen::Vector3f& direction, float maxDistance, TFunc&& func) const
+	{
+		if (m_NumLeaves == 0)
+		{
+			return;
+		}
+
+		const Eigen::Vector3f inverseDirection = direction.cwiseInverse();
+		auto hitDistance = [&](const Aabb& bounds)
+		{
+			const Eigen::Array3f t1 = (bounds.Min - origin).array() * inverseDirection.array();
+			const Eigen::Array3f t2 = (bounds.Max - origin).array() * inverseDirection.array();
+			const float tMin = std::max(t1.min(t2).maxCoeff(), 0.0f);
+			const float tMax = t1.max(t2).minCoeff();
+			return tMin <= tMax ? tMin : -1.0f;
+		};
+
+		uint32_t stack[STACK_SIZE];
+		int32_t count = 0;
+		stack[count++] = m_Root;
+
+		while (count > 0)
+		{
+			const uint32_t node = stack[--count];
+			const float t = hitDistance(GetBounds(node));
+			if (t < 0.0f || t > maxDistance)
+			{
+				continue;
+			}
+
+			if (node & LEAF_BIT)
+			{
+				maxDistance = func(m_LeafBodies[node & ~LEAF_BIT], maxDistance);
+				if (maxDistance <= 0.0f)
+				{
+					return;
+				}
+			}
+			else if (count + 2 <= STACK_SIZE)
+			{
+				stack[count++] = m_Nodes[node].Left;
+				stack[count++] = m_Nodes[node].Right;
+			}
+		}
+	}
+
+	inline const Aabb& LinearBvh::GetBounds(const uint32_t child) const
+	{
+		return (child & LEAF_BIT) ? m_LeafBounds[child & ~LEAF_BIT] : m_Nodes[child].Bounds;
+	}
+}
\ No newline at end of file
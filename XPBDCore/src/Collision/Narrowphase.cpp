@@ -0,0 +1,113 @@
+#include "Narrowphase.h"
+#include "Collision/BoxCollision.h"
+#include "Collision/ConvexShapes.h"
+#include "Simulation/JobSystem.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	namespace
+	{
+		SphereShape MakeSphereShape(const BodyStore& bodies, BodyHandle body)
+		{
+			return SphereShape{ bodies.Positions[body], bodies.Colliders[body].Radius * bodies.Scales[body].maxCoeff() };
+		}
+
+		template<typename TShape>
+		bool CollideWith(BodyStore& bodies, const TShape& shape1, BodyHandle body2, ContactManifold& manifold, GjkCache* cache)
+		{
+			switch (bodies.Colliders[body2].Type)
+			{
+			case ColliderType::Box:
+				return CollideConvex(shape1, MakeOrientedBox(bodies, body2), manifold, cache);
+			case ColliderType::Sphere:
+				return CollideConvex(shape1, MakeSphereShape(bodies, body2), manifold, cache);
+			default:
+				return false;
+			}
+		}
+	}
+
+	bool CollideBodies(BodyStore& bodies, BodyHandle body1, BodyHandle body2, ContactManifold& manifold, GjkCache* cache)
+	{
+		manifold.Body1 = body1;
+		manifold.Body2 = body2;
+		manifold.NumPoints = 0;
+
+		const ColliderType type1 = bodies.Colliders[body1].Type;
+		const ColliderType type2 = bodies.Colliders[body2].Type;
+		if (type1 == ColliderType::Box && type2 == ColliderType::Box)
+		{
+			return CollideBoxes(MakeOrientedBox(bodies, body1), MakeOrientedBox(bodies, body2), manifold);
+		}
+
+		switch (type1)
+		{
+		case ColliderType::Box:
+			return CollideWith(bodies, MakeOrientedBox(bodies, body1), body2, manifold, cache);
+		case ColliderType::Sphere:
+			return CollideWith(bodies, MakeSphereShape(bodies, body1), body2, manifold, cache);
+		default:
+			return false;
+		}
+	}
+
+	void GjkPairCaches::Update(const std::vector<BodyPair>& pairs)
+	{
+		// The order of the bodies is part of the key, the cached directions point from the first shape to the second.
+		m_NextKeys.resize(pairs.size());
+		for (uint32_t i = 0; i < (uint32_t)pairs.size(); ++i)
+		{
+			m_NextKeys[i] = PairKey{ ((uint64_t)pairs[i].Body1 << 32) | pairs[i].Body2, i };
+		}
+		std::sort(m_NextKeys.begin(), m_NextKeys.end(), [](const PairKey& a, const PairKey& b) { return a.Key < b.Key; });
+
+		// Both key lists are sorted, one merge walk finds the pairs that stayed.
+		m_NextCaches.assign(pairs.size(), GjkCache{});
+		size_t previous = 0;
+		for (const PairKey& next : m_NextKeys)
+		{
+			while (previous < m_Keys.size() && m_Keys[previous].Key < next.Key)
+			{
+				++previous;
+			}
+
+			if (previous < m_Keys.size() && m_Keys[previous].Key == next.Key)
+			{
+				m_NextCaches[next.Pair] = m_Caches[m_Keys[previous].Pair];
+			}
+		}
+
+		std::swap(m_Keys, m_NextKeys);
+		std::swap(m_Caches, m_NextCaches);
+	}
+
+	GjkCache& GjkPairCaches::Get(uint32_t pair)
+	{
+		return m_Caches[pair];
+	}
+
+	void GjkPairCaches::Clear()
+	{
+		m_Keys.clear();
+		m_Caches.clear();
+	}
+
+	void CollidePairs(BodyStore& bodies, const std::vector<BodyPair>& pairs, std::vector<ContactManifold>& manifolds, GjkPairCaches* caches)
+	{
+		if (caches)
+		{
+			caches->Update(pairs);
+		}
+
+		manifolds.resize(pairs.size());
+		ParallelFor(0, (uint32_t)pairs.size(), [&](const uint32_t i)
+		{
+			CollideBodies(bodies, pairs[i].Body1, pairs[i].Body2, manifolds[i], caches ? &caches->Get(i) : nullptr);
+		}, 64);
+
+		manifolds.erase(std::remove_if(manifolds.begin(), manifolds.end(),
+			[](const ContactManifold& manifold) { return manifold.NumPoints == 0; }), manifolds.end());
+	}
+}
\ No newline at end of file
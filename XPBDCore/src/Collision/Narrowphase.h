@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+
+#include "Collision/Aabb.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/Gjk.h"
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Contact between the colliders of two bodies. Box pairs use the SAT routine for full manifolds,
+	* every other pair goes through GJK and EPA. Pass the cache of the pair to warm start GJK.
+	* Returns false when the colliders do not touch.
+	*/
+	bool CollideBodies(BodyStore& bodies, BodyHandle body1, BodyHandle body2, ContactManifold& manifold, GjkCache* cache = nullptr);
+
+	/**
+	* GJK caches of the persistent broadphase pairs, keyed by BodyPair.
+	* Update moves the cache of every pair that is still listed to the index of the pair in the new list,
+	* new pairs start with an empty cache. Allocation free once the pair count settled.
+	*/
+	class GjkPairCaches
+	{
+	public:
+		void Update(const std::vector<BodyPair>& pairs);
+		// Cache of the pair at the index it had in the last Update
+		GjkCache& Get(uint32_t pair);
+		void Clear();
+
+	private:
+		struct PairKey
+		{
+			uint64_t Key = 0;
+			uint32_t Pair = 0;
+		};
+
+		// Sorted by key, Pair indexes m_Caches
+		std::vector<PairKey> m_Keys;
+		std::vector<GjkCache> m_Caches;
+		std::vector<PairKey> m_NextKeys;
+		std::vector<GjkCache> m_NextCaches;
+	};
+
+	/**
+	* Runs CollideBodies in parallel over the broadphase pairs, warm started from caches when given.
+	* Only the touching pairs are written to manifolds, in the order of the pairs.
+	*/
+	void CollidePairs(BodyStore& bodies, const std::vector<BodyPair>& pairs, std::vector<ContactManifold>& manifolds, GjkPairCaches* caches = nullptr);
+}
\ No newline at end of file
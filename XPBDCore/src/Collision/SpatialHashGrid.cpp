@@ -0,0 +1,108 @@
+#include "SpatialHashGrid.h"
+#include "Simulation/JobSystem.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Simulation
+{
+	SpatialHashGrid::SpatialHashGrid(const float cellSize)
+	{
+		SetCellSize(cellSize);
+	}
+
+	void SpatialHashGrid::SetCellSize(const float cellSize)
+	{
+		assert(cellSize > 0.0f);
+		m_CellSize = cellSize;
+		m_InverseCellSize = 1.0f / cellSize;
+	}
+
+	float SpatialHashGrid::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	void SpatialHashGrid::Build(const std::vector<Eigen::Vector3f>& positions)
+	{
+		Build(positions.data(), (uint32_t)positions.size());
+	}
+
+	void SpatialHashGrid::Build(const Eigen::Vector3f* positions, const uint32_t count)
+	{
+		m_Positions = positions;
+		m_NumPoints = count;
+
+		uint32_t tableSize = 64;
+		while (tableSize < 2 * count)
+		{
+			tableSize <<= 1;
+		}
+		m_TableSize = tableSize;
+
+		if (m_BucketCapacity < tableSize)
+		{
+			m_BucketCounts.reset(new std::atomic<uint32_t>[tableSize]);
+			m_BucketCapacity = tableSize;
+		}
+		m_BucketStarts.resize(tableSize + 1);
+		m_SortedIndices.resize(count);
+		m_PointBuckets.resize(count);
+
+		ParallelFor(0, tableSize, [this](const uint32_t bucket)
+		{
+			m_BucketCounts[bucket].store(0, std::memory_order_relaxed);
+		}, 4096);
+
+		// Count
+		ParallelFor(0, count, [this](const uint32_t point)
+		{
+			const uint32_t bucket = HashCell(GetCell(m_Positions[point]));
+			m_PointBuckets[point] = bucket;
+			m_BucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+		}, 1024);
+
+		// Exclusive prefix sum, the counters become the write cursors of the scatter.
+		uint32_t offset = 0;
+		for (uint32_t bucket = 0; bucket < tableSize; ++bucket)
+		{
+			m_BucketStarts[bucket] = offset;
+			offset += m_BucketCounts[bucket].load(std::memory_order_relaxed);
+			m_BucketCounts[bucket].store(m_BucketStarts[bucket], std::memory_order_relaxed);
+		}
+		m_BucketStarts[tableSize] = offset;
+
+		// Scatter
+		ParallelFor(0, count, [this](const uint32_t point)
+		{
+			const uint32_t slot = m_BucketCounts[m_PointBuckets[point]].fetch_add(1, std::memory_order_relaxed);
+			m_SortedIndices[slot] = point;
+		}, 1024);
+
+		// The scatter order depends on thread timing, sort each bucket so queries visit points in a fixed order.
+		ParallelFor(0, tableSize, [this](const uint32_t bucket)
+		{
+			std::sort(m_SortedIndices.begin() + m_BucketStarts[bucket], m_SortedIndices.begin() + m_BucketStarts[bucket + 1]);
+		}, 1024);
+	}
+
+	const std::vector<uint32_t>& SpatialHashGrid::GetSortedIndices() const
+	{
+		return m_SortedIndices;
+	}
+
+	Eigen::Vector3i SpatialHashGrid::GetCell(const Eigen::Vector3f& position) const
+	{
+		return Eigen::Vector3i(
+			(int)std::floor(position.x() * m_InverseCellSize),
+			(int)std::floor(position.y() * m_InverseCellSize),
+			(int)std::floor(position.z() * m_InverseCellSize));
+	}
+
+	uint32_t SpatialHashGrid::HashCell(const Eigen::Vector3i& cell) const
+	{
+		// Teschner et al. 2003
+		const uint32_t hash = ((uint32_t)cell.x() * 73856093u) ^ ((uint32_t)cell.y() * 19349663u) ^ ((uint32_t)cell.z() * 83492791u);
+		return hash & (m_TableSize - 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+
+namespace Simulation
+{
+	/**
+	* Uniform grid over an unbounded space, cells are hashed into a table of buckets.
+	* Build assigns the points to buckets with a parallel counting sort and keeps one contiguous
+	* index array sorted by bucket, so neighbour queries walk at most 27 short ranges.
+	* All buffers are reused, rebuilding does not allocate once the point count stopped growing.
+	*/
+	class SpatialHashGrid
+	{
+	public:
+		explicit SpatialHashGrid(const float cellSize = 1.0f);
+
+		/**
+		* Queries must not use a radius larger than the cell size.
+		*/
+		void SetCellSize(const float cellSize);
+		float GetCellSize() const;
+
+		/**
+		* Sorts the points into the grid. The positions must stay alive and unchanged until the next Build.
+		*/
+		void Build(const Eigen::Vector3f* positions, const uint32_t count);
+		void Build(const std::vector<Eigen::Vector3f>& positions);
+
+		/**
+		* Calls func(pointIndex) for every point within radius of position, radius <= cell size.
+		*/
+		template<typename TFunc>
+		void QueryRadius(const Eigen::Vector3f& position, const float radius, TFunc&& func) const;
+
+		// Point indices, grouped by bucket
+		const std::vector<uint32_t>& GetSortedIndices() const;
+
+	private:
+		Eigen::Vector3i GetCell(const Eigen::Vector3f& position) const;
+		uint32_t HashCell(const Eigen::Vector3i& cell) const;
+
+	private:
+		float m_CellSize = 1.0f;
+		float m_InverseCellSize = 1.0f;
+
+		const Eigen::Vector3f* m_Positions = nullptr;
+		uint32_t m_NumPoints = 0;
+
+		// Power of two, at least twice the number of points
+		uint32_t m_TableSize = 0;
+		std::unique_ptr<std::atomic<uint32_t>[]> m_BucketCounts;
+		uint32_t m_BucketCapacity = 0;
+
+		// m_BucketStarts[b]..m_BucketStarts[b + 1] is the range of bucket b in m_SortedIndices
+		std::vector<uint32_t> m_BucketStarts;
+		std::vector<uint32_t> m_SortedIndices;
+		std::vector<uint32_t> m_PointBuckets;
+	};
+
+	template<typename TFunc>
+	void SpatialHashGrid::QueryRadius(const Eigen::Vector3f& position, const float radius, TFunc&& func) const
+	{
+		assert(radius <= m_CellSize);
+		if (m_NumPoints == 0)
+		{
+			return;
+		}
+
+		const Eigen::Vector3i minCell = GetCell((position.array() - radius).matrix());
+		const Eigen::Vector3i maxCell = GetCell((position.array() + radius).matrix());
+		const float radiusSq = radius * radius;
+
+		// Different cells can hash to the same bucket, each bucket must only be visited once.
+		uint32_t visited[27];
+		uint32_t numVisited = 0;
+
+		for (int x = minCell.x(); x <= maxCell.x(); ++x)
+		{
+			for (int y = minCell.y(); y <= maxCell.y(); ++y)
+			{
+				for (int z = minCell.z(); z <= maxCell.z(); ++z)
+				{
+					const uint32_t bucket = HashCell(Eigen::Vector3i(x, y, z));
+
+					bool seen = false;
+					for (uint32_t k = 0; k < numVisited; ++k)
+					{
+						seen |= visited[k] == bucket;
+					}
+					if (seen || numVisited == 27)
+					{
+						continue;
+					}
+					visited[numVisited++] = bucket;
+
+					for (uint32_t k = m_BucketStarts[bucket]; k < m_BucketStarts[bucket + 1]; ++k)
+					{
+						const uint32_t point = m_SortedIndices[k];
+						if ((m_Positions[point] - position).squaredNorm() <= radiusSq)
+						{
+							func(point);
+						}
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
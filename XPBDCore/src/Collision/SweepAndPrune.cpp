@@ -0,0 +1,134 @@
+#include "SweepAndPrune.h"
+#include "Simulation/JobSystem.h"
+
+namespace Simulation
+{
+	namespace
+	{
+		constexpr uint32_t INACTIVE_SLOT = UINT32_MAX;
+	}
+
+	void SweepAndPrune::Update(BodyStore& bodies, const float margin)
+	{
+		if (m_Bounds.size() != bodies.Size())
+		{
+			Rebuild(bodies);
+		}
+
+		ParallelFor(0, (uint32_t)m_Bodies.size(), [&](const uint32_t i)
+		{
+			const BodyHandle body = m_Bodies[i];
+			m_Bounds[body] = ComputeBodyAabb(bodies, body).Fattened(margin);
+		});
+
+		for (Endpoint& endpoint : m_Endpoints)
+		{
+			const Aabb& bounds = m_Bounds[endpoint.Data >> 1];
+			endpoint.Value = (endpoint.Data & 1) ? bounds.Max.x() : bounds.Min.x();
+		}
+
+		SortEndpoints();
+		FindPairs(bodies);
+	}
+
+	const std::vector<BodyPair>& SweepAndPrune::GetPairs() const
+	{
+		return m_Pairs;
+	}
+
+	const std::vector<Aabb>& SweepAndPrune::GetBounds() const
+	{
+		return m_Bounds;
+	}
+
+	void SweepAndPrune::Clear()
+	{
+		m_Bodies.clear();
+		m_Endpoints.clear();
+		m_Bounds.clear();
+		m_ActiveSlots.clear();
+		m_Active.clear();
+		m_Pairs.clear();
+	}
+
+	void SweepAndPrune::Rebuild(const BodyStore& bodies)
+	{
+		m_Bodies.clear();
+		m_Endpoints.clear();
+		for (BodyHandle body = 0; body < bodies.Size(); ++body)
+		{
+			if (bodies.Colliders[body].Type == ColliderType::None)
+			{
+				continue;
+			}
+
+			m_Bodies.push_back(body);
+			m_Endpoints.push_back({ 0.0f, body << 1 });
+			m_Endpoints.push_back({ 0.0f, (body << 1) | 1 });
+		}
+
+		m_Bounds.assign(bodies.Size(), Aabb{});
+		m_ActiveSlots.assign(bodies.Size(), INACTIVE_SLOT);
+	}
+
+	void SweepAndPrune::SortEndpoints()
+	{
+		// Insertion sort, the order of the last update is almost always still valid.
+		// Min endpoints go first on ties so touching boxes are reported.
+		for (size_t i = 1; i < m_Endpoints.size(); ++i)
+		{
+			const Endpoint endpoint = m_Endpoints[i];
+			size_t j = i;
+			while (j > 0 && (m_Endpoints[j - 1].Value > endpoint.Value ||
+				(m_Endpoints[j - 1].Value == endpoint.Value && (m_Endpoints[j - 1].Data & 1) > (endpoint.Data & 1))))
+			{
+				m_Endpoints[j] = m_Endpoints[j - 1];
+				--j;
+			}
+			m_Endpoints[j] = endpoint;
+		}
+	}
+
+	void SweepAndPrune::FindPairs(const BodyStore& bodies)
+	{
+		m_Pairs.clear();
+		m_Active.clear();
+
+		for (const Endpoint& endpoint : m_Endpoints)
+		{
+			const BodyHandle body = endpoint.Data >> 1;
+			if (endpoint.Data & 1)
+			{
+				// Swap-remove from the active list
+				const uint32_t slot = m_ActiveSlots[body];
+				const BodyHandle last = m_Active.back();
+				m_Active[slot] = last;
+				m_ActiveSlots[last] = slot;
+				m_Active.pop_back();
+				m_ActiveSlots[body] = INACTIVE_SLOT;
+				continue;
+			}
+
+			// Everything active overlaps on x, test the other two axes.
+			const Aabb& bounds = m_Bounds[body];
+			const bool isStatic = bodies.IsStatic(body);
+			for (const BodyHandle other : m_Active)
+			{
+				if (isStatic && bodies.IsStatic(other))
+				{
+					continue;
+				}
+
+				const Aabb& otherBounds = m_Bounds[other];
+				if (bounds.Min.y() <= otherBounds.Max.y() && otherBounds.Min.y() <= bounds.Max.y() &&
+					bounds.Min.z() <= otherBounds.Max.z() && otherBounds.Min.z() <= bounds.Max.z())
+				{
+					m_Pairs.push_back(body < other ? BodyPair{ body, other } : BodyPair{ other, body });
+				}
+			}
+
+			m_ActiveSlots[body] = (uint32_t)m_Active.size();
+			m_Active.push_back(body);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Collision/Aabb.h"
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Sweep-and-prune broadphase over the bodies that have a collider.
+	* The endpoints along the x axis stay sorted between updates and are re-sorted with an insertion sort,
+	* which is close to O(n) when bodies move little from one update to the next.
+	*/
+	class SweepAndPrune
+	{
+	public:
+		/**
+		* Refreshes the bounds of every collider, fattened by margin, and rebuilds the pair list.
+		* Pairs of two static bodies are skipped.
+		*/
+		void Update(BodyStore& bodies, const float margin = 0.0f);
+
+		const std::vector<BodyPair>& GetPairs() const;
+		const std::vector<Aabb>& GetBounds() const;
+
+		/**
+		* Forgets every body, call it after colliders were added or removed so the next Update rebuilds the endpoints.
+		*/
+		void Clear();
+
+	private:
+		void Rebuild(const BodyStore& bodies);
+		void SortEndpoints();
+		void FindPairs(const BodyStore& bodies);
+
+	private:
+		struct Endpoint
+		{
+			float Value;
+			// (body << 1) | 1 for the max endpoint
+			uint32_t Data;
+		};
+
+		// Bodies that have a collider, the endpoints are rebuilt when this set changes.
+		std::vector<BodyHandle> m_Bodies;
+		std::vector<Endpoint> m_Endpoints;
+
+		// Indexed by body handle
+		std::vector<Aabb> m_Bounds;
+		std::vector<uint32_t> m_ActiveSlots;
+
+		// Bodies whose x interval contains the sweep position
+		std::vector<BodyHandle> m_Active;
+		std::vector<BodyPair> m_Pairs;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include <Eigen/Dense>
+#include "Simulation/BodyStore.h"
+#include "Simulation/Float3.h"
+
+namespace Simulation
+{
+	struct TransformationData;
+
+	/**
+	* Common data of every constraint type.
+	* There are no virtual functions: each concrete type provides its own Init and Solve,
+	* and the ConstraintRegistry keeps one pool per type and calls them directly.
+	*/
+	struct Constraint
+	{
+		float Lambda = 0.0f;
+		float Compliance = 0.0f;
+
+		void Init() { Lambda = 0.0f; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+#include <cfloat>
+#include <Eigen/Dense>
+
+#include "Simulation/Simd.h"
+
+/**
+* Constraint math written once over the lane type T.
+* The scalar solvers instantiate it with float, the batched solvers with Simd::FloatLanes.
+* Both evaluate the same operations in the same order, so with contraction and reassociation
+* disabled (the strictfp build option, XPBD_STRICT_FP) they produce bit-identical results.
+*/
+namespace Simulation
+{
+	inline Simd::Vector3T<float> ToKernel(const Eigen::Vector3f& v)
+	{
+		return { v.x(), v.y(), v.z() };
+	}
+
+	inline Simd::QuaternionT<float> ToKernel(const Eigen::Quaternionf& q)
+	{
+		return { q.x(), q.y(), q.z(), q.w() };
+	}
+
+	inline Simd::Matrix3T<float> ToKernel(const Eigen::Matrix3f& m)
+	{
+		return { {
+			m(0, 0), m(0, 1), m(0, 2),
+			m(1, 0), m(1, 1), m(1, 2),
+			m(2, 0), m(2, 1), m(2, 2) } };
+	}
+
+	inline Eigen::Vector3f FromKernel(const Simd::Vector3T<float>& v)
+	{
+		return Eigen::Vector3f(v.X, v.Y, v.Z);
+	}
+
+	inline Eigen::Quaternionf FromKernel(const Simd::QuaternionT<float>& q)
+	{
+		return Eigen::Quaternionf(q.W, q.X, q.Y, q.Z);
+	}
+
+	/**
+	* Error of a RotationalConstraint that keeps the relative orientation of two bodies at identity:
+	* the vector part of 2 * q1 * q2^-1, with q2^-1 taken as the conjugate of the unit quaternion.
+	*/
+	template<typename T>
+	Simd::Vector3T<T> ComputeRotationalError(const Simd::QuaternionT<T>& q1, const Simd::QuaternionT<T>& q2)
+	{
+		const T two = T(2.0f);
+		return {
+			two * (q1.X * q2.W - q1.W * q2.X - q1.Y * q2.Z + q1.Z * q2.Y),
+			two * (q1.Y * q2.W - q1.W * q2.Y - q1.Z * q2.X + q1.X * q2.Z),
+			two * (q1.Z * q2.W - q1.W * q2.Z - q1.X * q2.Y + q1.Y * q2.X) };
+	}
+
+	template<typename T>
+	struct RotationalCorrection
+	{
+		typename Simd::LaneTraits<T>::Mask Valid;
+		T DeltaLambda;
+		// Rotation vectors for the two bodies, applied with Simd::ApplyRotationCorrection
+		Simd::Vector3T<T> DeltaRotation1;
+		Simd::Vector3T<T> DeltaRotation2;
+	};
+
+	/**
+	* One XPBD step of a rotational constraint. Lanes where the error or the generalized inverse mass
+	* is too small are marked invalid and must leave the bodies and Lambda untouched.
+	*/
+	template<typename T>
+	RotationalCorrection<T> ComputeRotationalCorrection(const Simd::Vector3T<T>& error,
+		const Simd::Matrix3T<T>& invTensor1, const Simd::Matrix3T<T>& invTensor2,
+		const T compliance, const T lambda, const T substepTime)
+	{
+		using namespace Simd;
+		const T epsilon = T(FLT_EPSILON);
+		RotationalCorrection<T> result;
+
+		const T theta = Sqrt(Dot(error, error));
+		result.Valid = theta > epsilon;
+
+		const Vector3T<T> n = error / Max(theta, epsilon);
+
+		const T e1InvMass = Dot(n, invTensor1 * n);
+		const T e2InvMass = Dot(n, invTensor2 * n);
+
+		const T alphaTilde = compliance / (substepTime * substepTime);
+
+		const T invMassSum = e1InvMass + e2InvMass;
+		result.Valid = result.Valid & (invMassSum > epsilon);
+
+		result.DeltaLambda = Select(result.Valid, (-theta - alphaTilde * lambda) / (invMassSum + alphaTilde), T(0.0f));
+
+		const Vector3T<T> positionalImpulse = (-result.DeltaLambda) * n;
+		result.DeltaRotation1 = invTensor1 * positionalImpulse;
+		result.DeltaRotation2 = -(invTensor2 * positionalImpulse);
+		return result;
+	}
+}
@@ -0,0 +1,438 @@
+#include "ConstraintRegistry.h"
+
+namespace Simulation
+{
+	template<typename T>
+	static constexpr bool IsBodyPairConstraint = !std::is_same_v<T, VolumeConstraint>;
+
+	/**
+	* Constraints between static or sleeping bodies would not move anything.
+	*/
+	static bool IsSimulated(const BodyStore& bodies, const BodyHandle body1, const BodyHandle body2)
+	{
+		return (body1 != INVALID_BODY_HANDLE && bodies.IsSimulated(body1)) || (body2 != INVALID_BODY_HANDLE && bodies.IsSimulated(body2));
+	}
+
+	/**
+	* Only contacts bounce, the joints just damp.
+	*/
+	template<typename T>
+	static void SolveVelocity(BodyStore& bodies, const T& constraint, const float substepTime, const float restitutionThreshold)
+	{
+		if constexpr (std::is_same_v<T, ContactConstraint>)
+		{
+			constraint.SolveVelocity(bodies, substepTime, restitutionThreshold);
+		}
+		else
+		{
+			constraint.SolveVelocity(bodies, substepTime);
+		}
+	}
+
+	template<typename T>
+	static void SolveConstraint(BodyStore& bodies, ConstraintPool<T>& pool, const uint32_t index, const int iteration, const float substepTime, ConstraintCorrection* correction)
+	{
+		T& constraint = pool.Constraints[index];
+		if (!IsSimulated(bodies, constraint.Body1, constraint.Body2))
+		{
+			return;
+		}
+
+		TransformationData& data = pool.Data[index];
+		if (iteration == 0)
+		{
+			constraint.Init();
+			data = GetTransformationData(bodies, constraint.Body1, constraint.Body2);
+		}
+
+		constraint.PrepareSolve(data);
+
+		data.Correction = correction;
+		constraint.Solve(data, substepTime);
+	}
+
+	static void SolvePool(BodyStore& bodies, ConstraintPool<VolumeConstraint>& pool, const int iteration, const float substepTime)
+	{
+		for (VolumeConstraint& constraint : pool.Constraints)
+		{
+			if (iteration == 0)
+			{
+				constraint.Init();
+			}
+			constraint.Solve(bodies, substepTime);
+		}
+	}
+
+	/**
+	* Coloring of the whole pool, rebuilt when constraints were added or replaced, or a body changed its static flag.
+	*/
+	template<typename T>
+	static const ConstraintColoring& GetColoring(const BodyStore& bodies, ConstraintPool<T>& pool)
+	{
+		if (!pool.ColoringValid || pool.ColoringStaticVersion != bodies.StaticVersion || pool.Coloring.Order.size() != pool.Constraints.size())
+		{
+			pool.Coloring.Build(bodies, pool.Constraints);
+			pool.ColoringStaticVersion = bodies.StaticVersion;
+			pool.ColoringValid = true;
+		}
+		return pool.Coloring;
+	}
+
+	template<typename T>
+	static void SolvePool(BodyStore& bodies, ConstraintPool<T>& pool, const int iteration, const float substepTime)
+	{
+		if (iteration == 0)
+		{
+			pool.Data.resize(pool.Constraints.size());
+		}
+
+		SolveColored(GetColoring(bodies, pool), [&](const uint32_t j)
+		{
+			SolveConstraint(bodies, pool, j, iteration, substepTime, nullptr);
+		});
+	}
+
+	/**
+	* Island of the dynamic bodies of a constraint, shared when they disagree or one is unknown.
+	*/
+	static uint32_t GetConstraintIsland(const BodyStore& bodies, const BodyIslands& islands, const BodyHandle body1, const BodyHandle body2, const uint32_t sharedIsland)
+	{
+		uint32_t island = INVALID_ISLAND;
+		for (const BodyHandle body : { body1, body2 })
+		{
+			if (body == INVALID_BODY_HANDLE || bodies.IsStatic(body))
+			{
+				continue;
+			}
+
+			const uint32_t bodyIsland = islands.GetIsland(body);
+			if (bodyIsland == INVALID_ISLAND || (island != INVALID_ISLAND && island != bodyIsland))
+			{
+				return sharedIsland;
+			}
+			island = bodyIsland;
+		}
+		return island == INVALID_ISLAND ? sharedIsland : island;
+	}
+
+	size_t ConstraintRegistry::Size() const
+	{
+		size_t size = 0;
+		ForEachPool([&size](const auto& pool) { size += pool.size(); });
+		return size;
+	}
+
+	void ConstraintRegistry::Clear()
+	{
+		std::apply([](auto&... pools) { ((pools.Constraints.clear(), pools.Data.clear(), pools.IslandOrder.clear(), pools.IslandStarts.clear(), pools.ColoringValid = false), ...); }, m_Pools);
+		m_NumIslands = 0;
+	}
+
+	void ConstraintRegistry::Prepare(const BodyStore& bodies, const SolverMode mode)
+	{
+		if (mode != SolverMode::Jacobi)
+		{
+			return;
+		}
+
+		m_Scratch.clear();
+		GetBodyPairs(m_Scratch);
+		m_Jacobi.Build(bodies, m_Scratch);
+	}
+
+	void ConstraintRegistry::GetBodyPairs(std::vector<ConstraintBodies>& pairs) const
+	{
+		ForEachPool([&pairs](const auto& pool)
+		{
+			using T = typename std::decay_t<decltype(pool)>::value_type;
+			if constexpr (IsBodyPairConstraint<T>)
+			{
+				for (const T& constraint : pool)
+				{
+					pairs.push_back({ constraint.Body1, constraint.Body2 });
+				}
+			}
+		});
+	}
+
+	void ConstraintRegistry::Solve(BodyStore& bodies, const int iteration, const float substepTime, const SolverMode mode, const float relaxation)
+	{
+		if (mode != SolverMode::Jacobi)
+		{
+			std::apply([&](auto&... pools) { (SolvePool(bodies, pools, iteration, substepTime), ...); }, m_Pools);
+			return;
+		}
+
+		// Corrections are laid out pool after pool, in the order Prepare collected the bodies.
+		m_Jacobi.Reset();
+		uint32_t firstCorrection = 0;
+		std::apply([&](auto&... pools)
+		{
+			auto solvePool = [&](auto& pool)
+			{
+				using T = typename std::decay_t<decltype(pool.Constraints)>::value_type;
+				if constexpr (IsBodyPairConstraint<T>)
+				{
+					if (iteration == 0)
+					{
+						pool.Data.resize(pool.Constraints.size());
+					}
+
+					ConstraintCorrection* corrections = m_Jacobi.Corrections.data() + firstCorrection;
+					ParallelFor(0, (uint32_t)pool.Constraints.size(), [&](const uint32_t j)
+					{
+						SolveConstraint(bodies, pool, j, iteration, substepTime, &corrections[j]);
+					});
+					firstCorrection += (uint32_t)pool.Constraints.size();
+				}
+			};
+			(solvePool(pools), ...);
+		}, m_Pools);
+		m_Jacobi.Apply(bodies, relaxation);
+
+		SolvePool(bodies, std::get<ConstraintPool<VolumeConstraint>>(m_Pools), iteration, substepTime);
+	}
+
+	void ConstraintRegistry::SetContacts(BodyStore& bodies, const std::vector<ContactManifold>& manifolds, const ContactMaterial& material)
+	{
+		ConstraintPool<ContactConstraint>& pool = std::get<ConstraintPool<ContactConstraint>>(m_Pools);
+		pool.Constraints.clear();
+		pool.ColoringValid = false;
+		AddContactConstraints(bodies, manifolds, material, pool.Constraints);
+	}
+
+	/**
+	* Wakes the islands of the sleeping bodies if any of the bodies is awake, returns true if an island woke up.
+	*/
+	template<size_t N>
+	static bool WakeLinkedIslands(BodyStore& bodies, BodyIslands& islands, const BodyHandle (&linked)[N])
+	{
+		bool isAwake = false;
+		for (const BodyHandle body : linked)
+		{
+			isAwake |= body != INVALID_BODY_HANDLE && bodies.IsSimulated(body);
+		}
+
+		if (!isAwake)
+		{
+			return false;
+		}
+
+		bool woke = false;
+		for (const BodyHandle body : linked)
+		{
+			if (body != INVALID_BODY_HANDLE)
+			{
+				woke |= islands.WakeIsland(bodies, body);
+			}
+		}
+		return woke;
+	}
+
+	void ConstraintRegistry::WakeIslands(BodyStore& bodies, BodyIslands& islands) const
+	{
+		// A woken island can touch the next sleeping one, the chain is short since most islands stay awake or asleep.
+		bool woke = true;
+		while (woke)
+		{
+			woke = false;
+			ForEachPool([&](const auto& pool)
+			{
+				using T = typename std::decay_t<decltype(pool)>::value_type;
+				for (const T& constraint : pool)
+				{
+					if constexpr (IsBodyPairConstraint<T>)
+					{
+						const BodyHandle linked[] = { constraint.Body1, constraint.Body2 };
+						woke |= WakeLinkedIslands(bodies, islands, linked);
+					}
+					else
+					{
+						woke |= WakeLinkedIslands(bodies, islands, constraint.Bodies);
+					}
+				}
+			});
+		}
+	}
+
+	void ConstraintRegistry::SolveVelocities(BodyStore& bodies, const float substepTime, const float restitutionThreshold)
+	{
+		std::apply([&](auto&... pools)
+		{
+			auto solvePool = [&](auto& pool)
+			{
+				using T = typename std::decay_t<decltype(pool.Constraints)>::value_type;
+				if constexpr (IsBodyPairConstraint<T>)
+				{
+					// Same cached coloring as the position solve, only the contact pool is recolored after SetContacts.
+					SolveColored(GetColoring(bodies, pool), [&](const uint32_t j)
+					{
+						const T& constraint = pool.Constraints[j];
+						if (IsSimulated(bodies, constraint.Body1, constraint.Body2))
+						{
+							SolveVelocity(bodies, constraint, substepTime, restitutionThreshold);
+						}
+					});
+				}
+			};
+			(solvePool(pools), ...);
+		}, m_Pools);
+	}
+
+
+	void ConstraintRegistry::PartitionIslands(const BodyStore& bodies, const BodyIslands& islands)
+	{
+		m_NumIslands = (uint32_t)islands.GetNumIslands();
+		const uint32_t numGroups = m_NumIslands + 1;
+
+		std::apply([&](auto&... pools)
+		{
+			auto partitionPool = [&](auto& pool)
+			{
+				using T = typename std::decay_t<decltype(pool.Constraints)>::value_type;
+				if constexpr (IsBodyPairConstraint<T>)
+				{
+					const uint32_t numConstraints = (uint32_t)pool.Constraints.size();
+					// Islands initialize the solver data at their first iteration, they cannot resize it concurrently.
+					pool.Data.resize(numConstraints);
+
+					// Counting sort keeps the pool order inside every island
+					pool.IslandStarts.assign(numGroups + 1, 0);
+					m_ConstraintIslands.resize(numConstraints);
+					for (uint32_t j = 0; j < numConstraints; ++j)
+					{
+						const uint32_t island = GetConstraintIsland(bodies, islands, pool.Constraints[j].Body1, pool.Constraints[j].Body2, m_NumIslands);
+						m_ConstraintIslands[j] = island;
+						++pool.IslandStarts[island + 1];
+					}
+
+					for (uint32_t group = 0; group < numGroups; ++group)
+					{
+						pool.IslandStarts[group + 1] += pool.IslandStarts[group];
+					}
+
+					pool.IslandOrder.resize(numConstraints);
+					m_IslandCursors.assign(pool.IslandStarts.begin(), pool.IslandStarts.end() - 1);
+					for (uint32_t j = 0; j < numConstraints; ++j)
+					{
+						pool.IslandOrder[m_IslandCursors[m_ConstraintIslands[j]]++] = j;
+					}
+
+					// The shared group runs alone, its constraints are spread over the workers by color instead.
+					m_Scratch.clear();
+					for (uint32_t i = pool.IslandStarts[m_NumIslands]; i < numConstraints; ++i)
+					{
+						const T& constraint = pool.Constraints[pool.IslandOrder[i]];
+						m_Scratch.push_back({ constraint.Body1, constraint.Body2 });
+					}
+					pool.SharedColoring.Build(bodies, m_Scratch);
+				}
+			};
+			(partitionPool(pools), ...);
+		}, m_Pools);
+	}
+
+	void ConstraintRegistry::GetIslandConstraintCounts(std::vector<uint32_t>& counts) const
+	{
+		counts.assign(m_NumIslands, 0);
+		std::apply([&](const auto&... pools)
+		{
+			auto countPool = [&](const auto& pool)
+			{
+				if (pool.IslandStarts.size() != m_NumIslands + 2)
+				{
+					return;
+				}
+
+				for (uint32_t island = 0; island < m_NumIslands; ++island)
+				{
+					counts[island] += pool.IslandStarts[island + 1] - pool.IslandStarts[island];
+				}
+			};
+			(countPool(pools), ...);
+		}, m_Pools);
+	}
+
+	uint32_t ConstraintRegistry::GetSharedIsland() const
+	{
+		return m_NumIslands;
+	}
+
+	void ConstraintRegistry::SolveIsland(BodyStore& bodies, const uint32_t island, const int iteration, const float substepTime)
+	{
+		std::apply([&](auto&... pools)
+		{
+			auto solvePool = [&](auto& pool)
+			{
+				using T = typename std::decay_t<decltype(pool.Constraints)>::value_type;
+				if constexpr (IsBodyPairConstraint<T>)
+				{
+					if (island + 1 >= pool.IslandStarts.size())
+					{
+						return;
+					}
+
+					const uint32_t start = pool.IslandStarts[island];
+					if (island == m_NumIslands)
+					{
+						SolveColored(pool.SharedColoring, [&](const uint32_t i)
+						{
+							SolveConstraint(bodies, pool, pool.IslandOrder[start + i], iteration, substepTime, nullptr);
+						});
+						return;
+					}
+
+					for (uint32_t i = start; i < pool.IslandStarts[island + 1]; ++i)
+					{
+						SolveConstraint(bodies, pool, pool.IslandOrder[i], iteration, substepTime, nullptr);
+					}
+				}
+				else if (island == m_NumIslands)
+				{
+					SolvePool(bodies, pool, iteration, substepTime);
+				}
+			};
+			(solvePool(pools), ...);
+		}, m_Pools);
+	}
+
+	void ConstraintRegistry::SolveIslandVelocities(BodyStore& bodies, const uint32_t island, const float substepTime, const float restitutionThreshold)
+	{
+		std::apply([&](auto&... pools)
+		{
+			auto solvePool = [&](auto& pool)
+			{
+				using T = typename std::decay_t<decltype(pool.Constraints)>::value_type;
+				if constexpr (IsBodyPairConstraint<T>)
+				{
+					if (island + 1 >= pool.IslandStarts.size())
+					{
+						return;
+					}
+
+					auto solveVelocity = [&](const uint32_t index)
+					{
+						const T& constraint = pool.Constraints[index];
+						if (IsSimulated(bodies, constraint.Body1, constraint.Body2))
+						{
+							SolveVelocity(bodies, constraint, substepTime, restitutionThreshold);
+						}
+					};
+
+					const uint32_t start = pool.IslandStarts[island];
+					if (island == m_NumIslands)
+					{
+						SolveColored(pool.SharedColoring, [&](const uint32_t i) { solveVelocity(pool.IslandOrder[start + i]); });
+						return;
+					}
+
+					for (uint32_t i = start; i < pool.IslandStarts[island + 1]; ++i)
+					{
+						solveVelocity(pool.IslandOrder[i]);
+					}
+				}
+			};
+			(solvePool(pools), ...);
+		}, m_Pools);
+	}
+}
\ No newline at end of file
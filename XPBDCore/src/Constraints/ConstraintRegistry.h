@@ -0,0 +1,180 @@
+#pragma once
+#include <tuple>
+#include <vector>
+#include <type_traits>
+
+#include "Constraints/ContactConstraint.h"
+#include "Constraints/HingeConstraint.h"
+#include "Constraints/PositionalConstraint.h"
+#include "Constraints/RotationalConstraint.h"
+#include "Constraints/TransformationData.h"
+#include "Constraints/VolumeConstraint.h"
+#include "Simulation/BodyStore.h"
+#include "Simulation/ConstraintColoring.h"
+#include "Simulation/Islands.h"
+#include "Simulation/JacobiCorrections.h"
+
+namespace Simulation
+{
+	/**
+	* Contiguous storage for one constraint type.
+	* Data holds the per constraint solver state, rebuilt at the first iteration of every substep.
+	*/
+	template<typename T>
+	struct ConstraintPool
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Constraints stored in pools must be trivially copyable");
+
+		std::vector<T> Constraints;
+		std::vector<TransformationData> Data;
+
+		// Constraint indices grouped by island, filled by ConstraintRegistry::PartitionIslands
+		std::vector<uint32_t> IslandOrder;
+		// Offset of each island into IslandOrder, the last group holds the constraints shared between islands.
+		std::vector<uint32_t> IslandStarts;
+		// Colors of the shared group, indices relative to the start of the group in IslandOrder
+		ConstraintColoring SharedColoring;
+
+		// Colors of the whole pool, rebuilt on use once the pool or the static bodies changed
+		ConstraintColoring Coloring;
+		// BodyStore::StaticVersion the coloring was built against
+		uint32_t ColoringStaticVersion = 0;
+		bool ColoringValid = false;
+	};
+
+	/**
+	* Holds one pool per concrete constraint type, so scenes can mix types without pointers or virtual calls.
+	* ForEachPool visits the pools at compile time, every solver loop runs over a single type
+	* and calls its Solve directly.
+	*/
+	class ConstraintRegistry
+	{
+	public:
+		template<typename T>
+		std::vector<T>& GetPool() { return std::get<ConstraintPool<T>>(m_Pools).Constraints; }
+
+		template<typename T>
+		const std::vector<T>& GetPool() const { return std::get<ConstraintPool<T>>(m_Pools).Constraints; }
+
+		/**
+		* Adds a copy of the constraint to its pool and returns its index in that pool.
+		*/
+		template<typename T>
+		uint32_t Add(const T& constraint);
+
+		/**
+		* Calls visitor(std::vector<T>&) once for every pool, in registration order.
+		*/
+		template<typename TVisitor>
+		void ForEachPool(TVisitor&& visitor);
+
+		template<typename TVisitor>
+		void ForEachPool(TVisitor&& visitor) const;
+
+		size_t Size() const;
+		void Clear();
+
+		/**
+		* Rebuilds the Jacobi body incidence when mode is Jacobi.
+		* Call at the start of a frame, after constraints or static flags changed.
+		*/
+		void Prepare(const BodyStore& bodies, const SolverMode mode);
+
+		/**
+		* Appends the bodies of every two body constraint, contacts included, in pool order.
+		*/
+		void GetBodyPairs(std::vector<ConstraintBodies>& pairs) const;
+
+		/**
+		* Runs one position iteration over every pool.
+		* Gauss-Seidel solves the pools one after the other, color by color with the constraints of a color
+		* in parallel. The colorings are cached and only rebuilt when a pool or the static bodies change.
+		* Jacobi records the corrections of all
+		* two body constraints and applies their average. Volume constraints always solve in place.
+		* Constraints whose bodies are all static or asleep are skipped.
+		*/
+		void Solve(BodyStore& bodies, const int iteration, const float substepTime, const SolverMode mode, const float relaxation);
+
+		/**
+		* Replaces the contact pool with the points of the manifolds.
+		* Contacts change every substep, call Prepare afterwards when solving with Jacobi.
+		*/
+		void SetContacts(BodyStore& bodies, const std::vector<ContactManifold>& manifolds, const ContactMaterial& material);
+
+		/**
+		* Wakes the island of every sleeping body a constraint or contact links to an awake body,
+		* until no more islands wake, so a body falling onto a sleeping stack is solved against a moving stack.
+		* Call after SetContacts and before PartitionIslands and the solve.
+		*/
+		void WakeIslands(BodyStore& bodies, BodyIslands& islands) const;
+
+		/**
+		* Velocity pass, run once the velocities were derived from the solved positions: joint damping,
+		* then contact friction and restitution. Uses the cached pool colorings of Solve, the constraints
+		* of a color are solved in parallel.
+		*/
+		void SolveVelocities(BodyStore& bodies, const float substepTime, const float restitutionThreshold);
+
+		/**
+		* Groups the two body constraints of every pool by the island of their dynamic bodies.
+		* Constraints linking two islands, or a body the islands do not know yet (a contact made since
+		* the islands were built), go to the shared group GetSharedIsland().
+		* Call after SetContacts, every substep the islands are solved.
+		*/
+		void PartitionIslands(const BodyStore& bodies, const BodyIslands& islands);
+
+		/**
+		* Constraint count of every island at the last PartitionIslands, the shared group excluded.
+		*/
+		void GetIslandConstraintCounts(std::vector<uint32_t>& counts) const;
+
+		uint32_t GetSharedIsland() const;
+
+		/**
+		* Gauss-Seidel position iteration over the constraints of one island, in pool order.
+		* Different islands share no dynamic body, so they can be solved on different threads.
+		* The shared group is colored by PartitionIslands, also solves the volume constraints and has to run alone.
+		*/
+		void SolveIsland(BodyStore& bodies, const uint32_t island, const int iteration, const float substepTime);
+
+		/**
+		* Velocity pass of one island, same rules as SolveIsland.
+		*/
+		void SolveIslandVelocities(BodyStore& bodies, const uint32_t island, const float substepTime, const float restitutionThreshold);
+
+	private:
+		std::tuple<
+			ConstraintPool<PositionalConstraint>,
+			ConstraintPool<RotationalConstraint>,
+			ConstraintPool<HingeConstraint>,
+			ConstraintPool<VolumeConstraint>,
+			ConstraintPool<ContactConstraint>> m_Pools;
+
+		JacobiCorrections m_Jacobi;
+		std::vector<ConstraintBodies> m_Scratch;
+		std::vector<uint32_t> m_ConstraintIslands;
+		std::vector<uint32_t> m_IslandCursors;
+		uint32_t m_NumIslands = 0;
+	};
+
+	template<typename T>
+	uint32_t ConstraintRegistry::Add(const T& constraint)
+	{
+		ConstraintPool<T>& pool = std::get<ConstraintPool<T>>(m_Pools);
+		pool.Constraints.push_back(constraint);
+		pool.ColoringValid = false;
+		return (uint32_t)(pool.Constraints.size() - 1);
+	}
+
+	template<typename TVisitor>
+	void ConstraintRegistry::ForEachPool(TVisitor&& visitor)
+	{
+		std::apply([&visitor](auto&... pools) { (visitor(pools.Constraints), ...); }, m_Pools);
+	}
+
+	template<typename TVisitor>
+	void ConstraintRegistry::ForEachPool(TVisitor&& visitor) const
+	{
+		std::apply([&visitor](const auto&... pools) { (visitor(pools.Constraints), ...); }, m_Pools);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "ContactConstraint.h"
+
+#include "Constraints/TransformationData.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Simulation
+{
+	namespace
+	{
+		/**
+		* Removes the positional error c along the unit direction n, moving Body1 against n and Body2 along it.
+		* Returns the change of the Lagrange multiplier, or zero when the error could not be corrected.
+		*/
+		float ApplyPositionalCorrection(const TransformationData& data, const Eigen::Vector3f& n, const float c, const float alphaTilde, const float lambda)
+		{
+			const BodyStore& bodies = *data.Bodies;
+			const float w1 = GetGeneralizedInverseMass(bodies, data.Body1, data.Body1InvTensor, data.WorldR1, n);
+			const float w2 = GetGeneralizedInverseMass(bodies, data.Body2, data.Body2InvTensor, data.WorldR2, n);
+			if (w1 + w2 <= FLT_EPSILON)
+			{
+				return 0.0f;
+			}
+
+			const float deltaLambda = (-c - alphaTilde * lambda) / (w1 + w2 + alphaTilde);
+			const Eigen::Vector3f impulse = deltaLambda * n;
+
+			if (bodies.IsSimulated(data.Body1))
+			{
+				CorrectPosition(data, data.Body1, bodies.InverseMasses[data.Body1] * impulse);
+				if (bodies.CanCorrectRotation(data.Body1))
+				{
+					CorrectRotation(data, data.Body1, data.Body1InvTensor * data.WorldR1.cross(impulse));
+				}
+			}
+
+			if (bodies.IsSimulated(data.Body2))
+			{
+				CorrectPosition(data, data.Body2, -bodies.InverseMasses[data.Body2] * impulse);
+				if (bodies.CanCorrectRotation(data.Body2))
+				{
+					CorrectRotation(data, data.Body2, -(data.Body2InvTensor * data.WorldR2.cross(impulse)));
+				}
+			}
+
+			return deltaLambda;
+		}
+	}
+
+	void ContactConstraint::Init()
+	{
+		Lambda = 0.0f;
+		TangentLambda = 0.0f;
+	}
+
+	void ContactConstraint::PrepareSolve(TransformationData& data) const
+	{
+		ComputePositionalData(data, LocalR1, LocalR2);
+	}
+
+	void ContactConstraint::Solve(const TransformationData& data, const float substepTime)
+	{
+		using namespace Eigen;
+
+		if (Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		const BodyStore& bodies = *data.Bodies;
+		const Vector3f n = Normal.ToEigen();
+		const Vector3f p1 = bodies.Positions[Body1] + data.WorldR1;
+		const Vector3f p2 = bodies.Positions[Body2] + data.WorldR2;
+
+		// Body1's point lies past Body2's point along the normal while they overlap.
+		const float depth = (p1 - p2).dot(n);
+		if (depth <= 0.0f)
+		{
+			return;
+		}
+
+		const float alphaTilde = Compliance / (substepTime * substepTime);
+		Lambda += ApplyPositionalCorrection(data, n, depth, alphaTilde, Lambda);
+
+		// Static friction: undo the relative tangential motion of the points over the substep.
+		// The normal correction may have rotated the bodies, so the points are taken again.
+		TransformationData frictionData = data;
+		frictionData.WorldR1 = bodies.Rotations[Body1] * LocalR1.ToEigen();
+		frictionData.WorldR2 = bodies.Rotations[Body2] * LocalR2.ToEigen();
+		const Vector3f currentP1 = bodies.Positions[Body1] + frictionData.WorldR1;
+		const Vector3f currentP2 = bodies.Positions[Body2] + frictionData.WorldR2;
+
+		const Vector3f previousP1 = bodies.PrevPositions[Body1] + bodies.PrevRotations[Body1] * LocalR1.ToEigen();
+		const Vector3f previousP2 = bodies.PrevPositions[Body2] + bodies.PrevRotations[Body2] * LocalR2.ToEigen();
+		const Vector3f deltaP = (currentP1 - previousP1) - (currentP2 - previousP2);
+		const Vector3f tangentialDeltaP = deltaP - deltaP.dot(n) * n;
+		const float tangentialError = tangentialDeltaP.norm();
+		if (tangentialError <= FLT_EPSILON)
+		{
+			return;
+		}
+
+		const Vector3f t = tangentialDeltaP / tangentialError;
+		const float w1 = GetGeneralizedInverseMass(bodies, Body1, data.Body1InvTensor, frictionData.WorldR1, t);
+		const float w2 = GetGeneralizedInverseMass(bodies, Body2, data.Body2InvTensor, frictionData.WorldR2, t);
+		if (w1 + w2 <= FLT_EPSILON)
+		{
+			return;
+		}
+
+		// Only stick while the tangential force stays inside the friction cone.
+		const float deltaTangentLambda = -tangentialError / (w1 + w2);
+		if (std::abs(TangentLambda + deltaTangentLambda) < StaticFriction * std::abs(Lambda))
+		{
+			TangentLambda += ApplyPositionalCorrection(frictionData, t, tangentialError, 0.0f, 0.0f);
+		}
+	}
+
+	void ContactConstraint::SolveVelocity(BodyStore& bodies, const float substepTime, const float restitutionThreshold) const
+	{
+		using namespace Eigen;
+
+		// Contacts that never overlapped during the position solve exert no force.
+		if (Lambda == 0.0f || Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		const Vector3f n = Normal.ToEigen();
+		const Vector3f r1 = bodies.GetRotationMatrix(Body1) * LocalR1.ToEigen();
+		const Vector3f r2 = bodies.GetRotationMatrix(Body2) * LocalR2.ToEigen();
+
+		const Vector3f v1 = bodies.LinearVelocities[Body1] + bodies.AngularVelocities[Body1].cross(r1);
+		const Vector3f v2 = bodies.LinearVelocities[Body2] + bodies.AngularVelocities[Body2].cross(r2);
+		const Vector3f relativeVelocity = v2 - v1;
+		const float normalVelocity = relativeVelocity.dot(n);
+		const Vector3f tangentialVelocity = relativeVelocity - normalVelocity * n;
+
+		Vector3f deltaV = Vector3f::Zero();
+
+		// Dynamic friction, limited by the normal force lambda / h^2 over the substep
+		const float tangentialSpeed = tangentialVelocity.norm();
+		if (tangentialSpeed > FLT_EPSILON)
+		{
+			const float normalForce = std::abs(Lambda) / (substepTime * substepTime);
+			deltaV -= (tangentialVelocity / tangentialSpeed) * std::min(substepTime * DynamicFriction * normalForce, tangentialSpeed);
+		}
+
+		// Restitution, relative to the approach speed before the position solve
+		const float restitution = std::abs(NormalVelocity) <= restitutionThreshold ? 0.0f : Restitution;
+		deltaV += n * (std::max(-restitution * NormalVelocity, 0.0f) - normalVelocity);
+
+		CorrectVelocity(bodies, Body1, Body2, r1, r2, deltaV);
+	}
+
+	void AddContactConstraints(BodyStore& bodies, const std::vector<ContactManifold>& manifolds, const ContactMaterial& material, std::vector<ContactConstraint>& constraints)
+	{
+		for (const ContactManifold& manifold : manifolds)
+		{
+			const Eigen::Matrix3f& rotation1 = bodies.GetRotationMatrix(manifold.Body1);
+			const Eigen::Matrix3f& rotation2 = bodies.GetRotationMatrix(manifold.Body2);
+
+			for (uint32_t i = 0; i < manifold.NumPoints; ++i)
+			{
+				const ContactPoint& point = manifold.Points[i];
+
+				ContactConstraint constraint;
+				constraint.Body1 = manifold.Body1;
+				constraint.Body2 = manifold.Body2;
+				constraint.Normal = manifold.Normal;
+				constraint.Compliance = material.Compliance;
+				constraint.StaticFriction = material.StaticFriction;
+				constraint.DynamicFriction = material.DynamicFriction;
+				constraint.Restitution = material.Restitution;
+
+				const Eigen::Vector3f r1 = point.PointOnBody1 - bodies.Positions[manifold.Body1];
+				const Eigen::Vector3f r2 = point.PointOnBody2 - bodies.Positions[manifold.Body2];
+				constraint.LocalR1 = rotation1.transpose() * r1;
+				constraint.LocalR2 = rotation2.transpose() * r2;
+
+				const Eigen::Vector3f v1 = bodies.LinearVelocities[manifold.Body1] + bodies.AngularVelocities[manifold.Body1].cross(r1);
+				const Eigen::Vector3f v2 = bodies.LinearVelocities[manifold.Body2] + bodies.AngularVelocities[manifold.Body2].cross(r2);
+				constraint.NormalVelocity = (v2 - v1).dot(manifold.Normal);
+
+				constraints.push_back(constraint);
+			}
+		}
+	}
+}
\ No newline at end of file
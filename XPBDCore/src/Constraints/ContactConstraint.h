@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+
+#include "Constraint.h"
+#include "Collision/ContactManifold.h"
+
+namespace Simulation
+{
+	/**
+	* Surface properties used when contact constraints are created from manifolds.
+	*/
+	struct ContactMaterial
+	{
+		float StaticFriction = 0.5f;
+		float DynamicFriction = 0.3f;
+		float Restitution = 0.0f;
+		float Compliance = 0.0f;
+	};
+
+	/**
+	* Non-penetration between two bodies at one contact point (Müller et al. 2020, section 3.5).
+	* The position solve pushes the points apart along the normal and cancels their tangential
+	* motion while the tangential multiplier stays inside the static friction cone.
+	* Dynamic friction and restitution are velocity level effects, applied by SolveVelocity.
+	*/
+	struct ContactConstraint: Constraint
+	{
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+
+		// Contact points in body space
+		Float3 LocalR1;
+		Float3 LocalR2;
+		// World space, pointing from Body1 towards Body2
+		Float3 Normal;
+
+		float TangentLambda = 0.0f;
+
+		float StaticFriction = 0.5f;
+		float DynamicFriction = 0.3f;
+		float Restitution = 0.0f;
+
+		// Separating velocity along the normal before the position solve, negative while approaching
+		float NormalVelocity = 0.0f;
+
+		void Init();
+
+		/**
+		* Updates the world space contact points in data for the current body rotations.
+		*/
+		void PrepareSolve(TransformationData& data) const;
+
+		void Solve(const TransformationData& data, const float substepTime);
+
+		/**
+		* Applies dynamic friction and restitution to the velocities derived from the position solve.
+		* Approaching speeds below restitutionThreshold do not bounce, which keeps resting contacts at rest.
+		*/
+		void SolveVelocity(BodyStore& bodies, const float substepTime, const float restitutionThreshold) const;
+	};
+
+	/**
+	* Appends one contact constraint per manifold point, with the points moved to body space.
+	* Call after integration, the current velocities become the pre-solve velocities used for restitution.
+	*/
+	void AddContactConstraints(BodyStore& bodies, const std::vector<ContactManifold>& manifolds, const ContactMaterial& material, std::vector<ContactConstraint>& constraints);
+}
\ No newline at end of file
@@ -3,27 +3,20 @@
 #include "PositionalConstraint.h"
 #include "RotationalConstraint.h"
 
-#include "Engine/Entity.h"
-#include "Engine/DebugDrawing.h"
 #include "Constraints/TransformationData.h"
 
-#include "raylib.h"
-#include "raymath.h"
-#include "imgui.h"
-#include "Engine/DebugDrawing.h"
-
-#include "Utils/EigenToRaylib.h"
-
-#include <iostream>
+#include <algorithm>
 
 namespace Simulation
 {
+	constexpr float PI = 3.14159265358979323846f;
+
 	static RotationalConstraint ConstructAlignmentConstraint(const HingeConstraint& constraint)
 	{
 		RotationalConstraint rot;
 		rot.Compliance = constraint.Compliance;
-		rot.Entity1 = constraint.Entity1;
-		rot.Entity2 = constraint.Entity2;
+		rot.Body1 = constraint.Body1;
+		rot.Body2 = constraint.Body2;
 		rot.Lambda = constraint.LambdaAlignAxis;
 		return rot;
 	}
@@ -32,12 +25,12 @@ namespace Simulation
 	{
 		PositionalConstraint pos;
 		pos.Compliance = 0.0f;
-		pos.Entity1 = constraint.Entity1;
-		pos.Entity2 = constraint.Entity2;
+		pos.Body1 = constraint.Body1;
+		pos.Body2 = constraint.Body2;
 		pos.Lambda = constraint.LambdaPositional;
 		pos.LocalR1 = constraint.E1AttachPoint;
 		pos.LocalR2 = constraint.E2AttachPoint;
-		pos.TargetDistance = Eigen::Vector3f::Zero();
+		pos.TargetDistance = Float3();
 		return pos;
 	}
 
@@ -45,9 +38,11 @@ namespace Simulation
 	{
 		const float minAngleRad = hingeConstraint.LimitAngleMin /** DEG2RAD*/;
 		const float maxAngleRad = hingeConstraint.LimitAngleMax /** DEG2RAD*/;
-		Eigen::Vector3f e1LimitAxisWorld = hingeConstraint.Entity1->Rotation.toRotationMatrix() * hingeConstraint.E1LimitAxis;
-		Eigen::Vector3f e2LimitAxisWorld = hingeConstraint.Entity2->Rotation.toRotationMatrix() * hingeConstraint.E2LimitAxis;
-		Eigen::Vector3f e1AlignAxisWorld = hingeConstraint.Entity1->Rotation.toRotationMatrix() * hingeConstraint.E1AlignAxis;
+		BodyStore& bodies = *data.Bodies;
+		const Eigen::Matrix3f& rotation1 = bodies.GetRotationMatrix(hingeConstraint.Body1);
+		Eigen::Vector3f e1LimitAxisWorld = rotation1 * hingeConstraint.E1LimitAxis.ToEigen();
+		Eigen::Vector3f e2LimitAxisWorld = bodies.GetRotationMatrix(hingeConstraint.Body2) * hingeConstraint.E2LimitAxis.ToEigen();
+		Eigen::Vector3f e1AlignAxisWorld = rotation1 * hingeConstraint.E1AlignAxis.ToEigen();
 
 		float phi = std::asin((e1LimitAxisWorld.cross(e2LimitAxisWorld)).dot(e1AlignAxisWorld));
 		if (e1LimitAxisWorld.dot(e2LimitAxisWorld) < 0.0f)
@@ -67,7 +62,7 @@ namespace Simulation
 
 		if (phi < minAngleRad || phi > maxAngleRad)
 		{
-			phi = Clamp(phi, minAngleRad,maxAngleRad);
+			phi = std::clamp(phi, minAngleRad, maxAngleRad);
 			e1LimitAxisWorld = Eigen::AngleAxisf(phi, e1AlignAxisWorld) * e1LimitAxisWorld;
 			Eigen::Vector3f deltaQ = e1LimitAxisWorld.cross(e2LimitAxisWorld);
 			RotationalConstraint rot = ConstructAlignmentConstraint(hingeConstraint);
@@ -83,17 +78,24 @@ namespace Simulation
 		LambdaPositional = 0.0f;
 	}
 
+	void HingeConstraint::PrepareSolve(TransformationData& data) const
+	{
+		ComputePositionalData(data, E1AttachPoint, E2AttachPoint);
+	}
+
 	void HingeConstraint::Solve(const TransformationData& data, const float substepTime)
 	{
 		using namespace Eigen;
 
-		if (!Entity1 || !Entity2)
+		if (Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
 		{
 			return;
 		}
 
-		const Eigen::Vector3f e1AlignAxisWorld = Entity1->Rotation.toRotationMatrix() * E1AlignAxis;
-		const Eigen::Vector3f e2AlignAxisWorld = Entity2->Rotation.toRotationMatrix() * E2AlignAxis;
+		BodyStore& bodies = *data.Bodies;
+
+		const Eigen::Vector3f e1AlignAxisWorld = bodies.GetRotationMatrix(Body1) * E1AlignAxis.ToEigen();
+		const Eigen::Vector3f e2AlignAxisWorld = bodies.GetRotationMatrix(Body2) * E2AlignAxis.ToEigen();
 		const Eigen::Vector3f deltaQ = e1AlignAxisWorld.cross(e2AlignAxisWorld);
 
 		RotationalConstraint alignmentConstraint = ConstructAlignmentConstraint(*this);
@@ -101,8 +103,8 @@ namespace Simulation
 		LambdaAlignAxis = alignmentConstraint.Lambda;
 
 
-		const Eigen::Vector3f p1 = Entity1->Position + data.WorldR1;
-		const Eigen::Vector3f p2 = Entity2->Position + data.WorldR2;
+		const Eigen::Vector3f p1 = bodies.Positions[Body1] + data.WorldR1;
+		const Eigen::Vector3f p2 = bodies.Positions[Body2] + data.WorldR2;
 		const Eigen::Vector3f deltaX = p1 - p2;
 		
 		PositionalConstraint positionalConstraint = ConstructPositionalConstraint(*this);
@@ -115,23 +117,14 @@ namespace Simulation
 		}
 	}
 
-	void HingeConstraint::DrawConstraint()
+	void HingeConstraint::SolveVelocity(BodyStore& bodies, const float substepTime) const
 	{
-		using namespace Utils::Math;
-		if (!Entity1 || !Entity2)
+		if (AngularDamping <= 0.0f || Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
 		{
 			return;
 		}
 
-		Eigen::Vector3f AlignAxis1World = Entity1->Rotation.toRotationMatrix() * E1AlignAxis.normalized();
-		Eigen::Vector3f AlignAxis2World = Entity2->Rotation.toRotationMatrix() * E2AlignAxis.normalized();
-		Eigen::Vector3f LimitAxis1World = Entity1->Rotation.toRotationMatrix() * E1LimitAxis.normalized();
-		Eigen::Vector3f LimitAxis2World = Entity2->Rotation.toRotationMatrix() * E2LimitAxis.normalized();
-
-		Engine::DebugDrawing::DrawDebugLine(ToVector3(Entity1->Position), ToVector3(Entity1->Position + 5 * AlignAxis1World), GREEN, 0.0f);
-		Engine::DebugDrawing::DrawDebugLine(ToVector3(Entity2->Position), ToVector3(Entity2->Position + 5 * AlignAxis2World), GREEN, 0.0f);
-
-		Engine::DebugDrawing::DrawDebugLine(ToVector3(Entity1->Position), ToVector3(Entity1->Position + 5 * LimitAxis1World), RED, 0.0f);
-		Engine::DebugDrawing::DrawDebugLine(ToVector3(Entity2->Position), ToVector3(Entity2->Position + 5 * LimitAxis2World), RED, 0.0f);
+		const float damping = std::min(AngularDamping * substepTime, 1.0f);
+		CorrectAngularVelocity(bodies, Body1, Body2, (bodies.AngularVelocities[Body1] - bodies.AngularVelocities[Body2]) * damping);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include "Constraint.h"
+
+namespace Simulation
+{
+	struct HingeConstraint: Constraint
+	{
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+
+		Float3 E1AlignAxis;
+		Float3 E2AlignAxis;
+
+		Float3 E1LimitAxis;
+		Float3 E2LimitAxis;
+
+		Float3 E1AttachPoint; // r1
+		Float3 E2AttachPoint; // r2
+
+		float LimitAngleMin = 0.0f;
+		float LimitAngleMax = 0.0f;
+
+		bool LimitAngle = false;
+
+		// Fraction of the relative angular velocity removed per second, slows the hinge down
+		float AngularDamping = 0.0f;
+
+		float LambdaAlignAxis = 0.0f;
+		float LambdaLimitAxis = 0.0f;
+		float LambdaPositional = 0.0f;
+
+		void Init();
+
+		/**
+		* Updates the world space attach points in data for the current body rotations.
+		*/
+		void PrepareSolve(TransformationData& data) const;
+
+		void Solve(const TransformationData& data, const float substepTime);
+
+		/**
+		* Damps the relative angular velocity of the bodies, after the velocities were derived.
+		*/
+		void SolveVelocity(BodyStore& bodies, const float substepTime) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "PositionalConstraint.h"
+
+#include "Constraints/TransformationData.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Simulation
+{
+	void PositionalConstraint::PrepareSolve(TransformationData& data) const
+	{
+		ComputePositionalData(data, LocalR1, LocalR2);
+	}
+
+	void PositionalConstraint::Solve(const TransformationData& data, const float substepTime)
+	{
+		using namespace Eigen;
+		const BodyStore& bodies = *data.Bodies;
+		const Vector3f deltaX = (bodies.Positions[Body1] + data.WorldR1 - bodies.Positions[Body2] - data.WorldR2) - TargetDistance.ToEigen();
+		Solve(data, substepTime, deltaX);
+	}
+
+	void PositionalConstraint::Solve(const TransformationData& data, const float substepTime, Eigen::Vector3f error)
+	{
+		using namespace Eigen;
+
+		if (Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		const BodyStore& bodies = *data.Bodies;
+
+		const float c = error.norm();
+		// Error too small
+		if (c <= FLT_EPSILON)
+		{
+			return;
+		}
+		const Vector3f n = error / c;
+
+		const Vector3f r1CrossN = data.WorldR1.cross(n);
+		const Vector3f r2CrossN = data.WorldR2.cross(n);
+
+		const float alphaTilde = Compliance / (substepTime * substepTime);
+
+		// Vector multiplication with a transpose results in dot product.
+		const float e1InvMass = bodies.InverseMasses[Body1] + r1CrossN.dot(data.Body1InvTensor * r1CrossN);
+		const float e2InvMass = bodies.InverseMasses[Body2] + r2CrossN.dot(data.Body2InvTensor * r2CrossN);
+		const float invMassSum = e1InvMass + e2InvMass;
+		if (invMassSum <= FLT_EPSILON)
+		{
+			return;
+		}
+
+		const float deltaLambda = (-c - alphaTilde * Lambda) / (invMassSum + alphaTilde);
+		const Vector3f positionalImpulse = deltaLambda * n;
+		if (bodies.IsSimulated(Body1))
+		{
+			CorrectPosition(data, Body1, bodies.InverseMasses[Body1] * positionalImpulse);
+		}
+
+		if (bodies.IsSimulated(Body2))
+		{
+			CorrectPosition(data, Body2, -bodies.InverseMasses[Body2] * positionalImpulse);
+		}
+
+		const Vector3f deltaQ1 = data.Body1InvTensor * (data.WorldR1.cross(positionalImpulse));
+		const Vector3f deltaQ2 = data.Body2InvTensor * (data.WorldR2.cross(positionalImpulse));
+
+		if (bodies.CanCorrectRotation(Body1))
+		{
+			CorrectRotation(data, Body1, deltaQ1);
+		}
+
+		if (bodies.CanCorrectRotation(Body2))
+		{
+			CorrectRotation(data, Body2, -deltaQ2);
+		}
+
+
+		Lambda += deltaLambda;
+	}
+
+	void PositionalConstraint::SolveVelocity(BodyStore& bodies, const float substepTime) const
+	{
+		using namespace Eigen;
+
+		if (LinearDamping <= 0.0f || Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		const Vector3f r1 = bodies.GetRotationMatrix(Body1) * LocalR1.ToEigen();
+		const Vector3f r2 = bodies.GetRotationMatrix(Body2) * LocalR2.ToEigen();
+		const Vector3f v1 = bodies.LinearVelocities[Body1] + bodies.AngularVelocities[Body1].cross(r1);
+		const Vector3f v2 = bodies.LinearVelocities[Body2] + bodies.AngularVelocities[Body2].cross(r2);
+
+		const float damping = std::min(LinearDamping * substepTime, 1.0f);
+		CorrectVelocity(bodies, Body1, Body2, r1, r2, (v1 - v2) * damping);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "Constraint.h"
+
+namespace Simulation
+{
+	struct PositionalConstraint: Constraint
+	{
+		Float3 LocalR1;
+		Float3 LocalR2;
+		Float3 TargetDistance;
+
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+
+		// Fraction of the relative velocity of the attachment points removed per second
+		float LinearDamping = 0.0f;
+
+		/**
+		* Updates the world space attachment points in data for the current body rotations.
+		*/
+		void PrepareSolve(TransformationData& data) const;
+
+		void Solve(const TransformationData& data, const float substepTime);
+		void Solve(const TransformationData& data, const float substepTime, Eigen::Vector3f error);
+
+		/**
+		* Damps the relative velocity of the attachment points, after the velocities were derived.
+		*/
+		void SolveVelocity(BodyStore& bodies, const float substepTime) const;
+	};
+}
\ No newline at end of file
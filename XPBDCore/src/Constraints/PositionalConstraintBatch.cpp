@@ -0,0 +1,250 @@
+#include "PositionalConstraintBatch.h"
+
+#include "Constraints/PositionalConstraint.h"
+#include "Constraints/TransformationData.h"
+#include "Simulation/ConstraintColoring.h"
+#include "Simulation/JobSystem.h"
+#include "Simulation/Simd.h"
+
+#include <algorithm>
+
+#include <cfloat>
+
+namespace Simulation
+{
+	void PositionalConstraintBatch::Build(const std::vector<PositionalConstraint>& constraints, const ConstraintColoring& coloring)
+	{
+		using Simd::LANE_WIDTH;
+
+		ColorPackStarts.clear();
+		ColorPackStarts.push_back(0);
+
+		// Count the packs first so every array is sized once
+		size_t numPacks = 0;
+		for (size_t color = 0; color < coloring.GetNumColors(); ++color)
+		{
+			const uint32_t colorSize = coloring.ColorStarts[color + 1] - coloring.ColorStarts[color];
+			numPacks += (colorSize + LANE_WIDTH - 1) / LANE_WIDTH;
+		}
+		Resize(numPacks * LANE_WIDTH);
+
+		uint32_t slot = 0;
+		for (size_t color = 0; color < coloring.GetNumColors(); ++color)
+		{
+			for (uint32_t k = coloring.ColorStarts[color]; k < coloring.ColorStarts[color + 1]; ++k)
+			{
+				const uint32_t source = coloring.Order[k];
+				const PositionalConstraint& constraint = constraints[source];
+				if (constraint.Body1 == INVALID_BODY_HANDLE || constraint.Body2 == INVALID_BODY_HANDLE)
+				{
+					continue;
+				}
+
+				Sources[slot] = source;
+				Bodies1[slot] = constraint.Body1;
+				Bodies2[slot] = constraint.Body2;
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					LocalR1[axis][slot] = constraint.LocalR1(axis);
+					LocalR2[axis][slot] = constraint.LocalR2(axis);
+					TargetDistance[axis][slot] = constraint.TargetDistance(axis);
+				}
+				Compliance[slot] = constraint.Compliance;
+				Lambda[slot] = constraint.Lambda;
+				++slot;
+			}
+
+			// Pad the color to a whole pack, padding slots point at body 0 and are never written back
+			slot = (slot + LANE_WIDTH - 1) / LANE_WIDTH * LANE_WIDTH;
+			ColorPackStarts.push_back(slot / LANE_WIDTH);
+		}
+	}
+
+	void PositionalConstraintBatch::Init()
+	{
+		std::fill(Lambda.begin(), Lambda.end(), 0.0f);
+		m_CaptureInverseInertia = true;
+	}
+
+	void PositionalConstraintBatch::Solve(BodyStore& bodies, const float substepTime)
+	{
+		for (size_t color = 0; color + 1 < ColorPackStarts.size(); ++color)
+		{
+			ParallelFor(ColorPackStarts[color], ColorPackStarts[color + 1], [this, &bodies, substepTime](const uint32_t pack)
+			{
+				if (m_CaptureInverseInertia)
+				{
+					CaptureInverseInertia(bodies, pack);
+				}
+				SolvePack(bodies, pack, substepTime);
+			}, 16);
+		}
+
+		m_CaptureInverseInertia = false;
+	}
+
+	void PositionalConstraintBatch::StoreLambdas(std::vector<PositionalConstraint>& constraints) const
+	{
+		for (size_t slot = 0; slot < Sources.size(); ++slot)
+		{
+			if (Sources[slot] != INVALID_SLOT)
+			{
+				constraints[Sources[slot]].Lambda = Lambda[slot];
+			}
+		}
+	}
+
+	size_t PositionalConstraintBatch::GetNumPacks() const
+	{
+		return Sources.size() / Simd::LANE_WIDTH;
+	}
+
+	void PositionalConstraintBatch::Resize(const size_t numSlots)
+	{
+		Sources.assign(numSlots, INVALID_SLOT);
+		Bodies1.assign(numSlots, 0);
+		Bodies2.assign(numSlots, 0);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			LocalR1[axis].assign(numSlots, 0.0f);
+			LocalR2[axis].assign(numSlots, 0.0f);
+			TargetDistance[axis].assign(numSlots, 0.0f);
+		}
+		Compliance.assign(numSlots, 0.0f);
+		Lambda.assign(numSlots, 0.0f);
+		for (int i = 0; i < 9; ++i)
+		{
+			InvTensor1[i].assign(numSlots, 0.0f);
+			InvTensor2[i].assign(numSlots, 0.0f);
+		}
+	}
+
+	void PositionalConstraintBatch::CaptureInverseInertia(BodyStore& bodies, const uint32_t pack)
+	{
+		for (uint32_t slot = pack * Simd::LANE_WIDTH; slot < (pack + 1) * Simd::LANE_WIDTH; ++slot)
+		{
+			if (Sources[slot] == INVALID_SLOT)
+			{
+				continue;
+			}
+
+			const Eigen::Matrix3f invTensor1 = ComputeWorldInverseInertia(bodies, Bodies1[slot]);
+			const Eigen::Matrix3f invTensor2 = ComputeWorldInverseInertia(bodies, Bodies2[slot]);
+			for (int i = 0; i < 9; ++i)
+			{
+				InvTensor1[i][slot] = invTensor1(i / 3, i % 3);
+				InvTensor2[i][slot] = invTensor2(i / 3, i % 3);
+			}
+		}
+	}
+
+	void PositionalConstraintBatch::SolvePack(BodyStore& bodies, const uint32_t pack, const float substepTime)
+	{
+		using namespace Simd;
+
+		const uint32_t first = pack * LANE_WIDTH;
+		const uint32_t* bodies1 = &Bodies1[first];
+		const uint32_t* bodies2 = &Bodies2[first];
+
+		// Gather body state. Eigen stores Vector3f as 3 floats and Quaternionf as x, y, z, w.
+		const float* positions = bodies.Positions[0].data();
+		const float* rotations = bodies.Rotations[0].coeffs().data();
+		const float* inverseMasses = bodies.InverseMasses.data();
+
+		const Vector3Lanes p1{ Gather(positions, bodies1, 3, 0), Gather(positions, bodies1, 3, 1), Gather(positions, bodies1, 3, 2) };
+		const Vector3Lanes p2{ Gather(positions, bodies2, 3, 0), Gather(positions, bodies2, 3, 1), Gather(positions, bodies2, 3, 2) };
+		const QuaternionLanes q1{ Gather(rotations, bodies1, 4, 0), Gather(rotations, bodies1, 4, 1), Gather(rotations, bodies1, 4, 2), Gather(rotations, bodies1, 4, 3) };
+		const QuaternionLanes q2{ Gather(rotations, bodies2, 4, 0), Gather(rotations, bodies2, 4, 1), Gather(rotations, bodies2, 4, 2), Gather(rotations, bodies2, 4, 3) };
+		const FloatLanes invMass1 = Gather(inverseMasses, bodies1, 1, 0);
+		const FloatLanes invMass2 = Gather(inverseMasses, bodies2, 1, 0);
+
+		Matrix3Lanes invTensor1;
+		Matrix3Lanes invTensor2;
+		for (int i = 0; i < 9; ++i)
+		{
+			invTensor1.M[i] = Load(&InvTensor1[i][first]);
+			invTensor2.M[i] = Load(&InvTensor2[i][first]);
+		}
+
+		const Vector3Lanes localR1{ Load(&LocalR1[0][first]), Load(&LocalR1[1][first]), Load(&LocalR1[2][first]) };
+		const Vector3Lanes localR2{ Load(&LocalR2[0][first]), Load(&LocalR2[1][first]), Load(&LocalR2[2][first]) };
+		const Vector3Lanes target{ Load(&TargetDistance[0][first]), Load(&TargetDistance[1][first]), Load(&TargetDistance[2][first]) };
+		const FloatLanes compliance = Load(&Compliance[first]);
+		const FloatLanes lambda = Load(&Lambda[first]);
+
+		const FloatLanes epsilon = Set1(FLT_EPSILON);
+
+		// Constraint error
+		const Vector3Lanes r1 = Rotate(q1, localR1);
+		const Vector3Lanes r2 = Rotate(q2, localR2);
+		const Vector3Lanes error = (p1 + r1 - p2 - r2) - target;
+
+		const FloatLanes c = Sqrt(Dot(error, error));
+		FloatLanes valid = c > epsilon;
+
+		const FloatLanes safeC = Max(c, epsilon);
+		const Vector3Lanes n{ error.X / safeC, error.Y / safeC, error.Z / safeC };
+
+		const Vector3Lanes r1CrossN = Cross(r1, n);
+		const Vector3Lanes r2CrossN = Cross(r2, n);
+
+		const FloatLanes alphaTilde = compliance / Set1(substepTime * substepTime);
+
+		const FloatLanes e1InvMass = invMass1 + Dot(r1CrossN, invTensor1 * r1CrossN);
+		const FloatLanes e2InvMass = invMass2 + Dot(r2CrossN, invTensor2 * r2CrossN);
+		const FloatLanes invMassSum = e1InvMass + e2InvMass;
+		valid = valid & (invMassSum > epsilon);
+
+		const FloatLanes deltaLambda = valid & ((-c - alphaTilde * lambda) / (invMassSum + alphaTilde));
+		const Vector3Lanes positionalImpulse = deltaLambda * n;
+
+		const Vector3Lanes newP1 = p1 + invMass1 * positionalImpulse;
+		const Vector3Lanes newP2 = p2 - invMass2 * positionalImpulse;
+
+		const Vector3Lanes deltaQ1 = invTensor1 * Cross(r1, positionalImpulse);
+		const Vector3Lanes deltaQ2 = invTensor2 * Cross(r2, positionalImpulse);
+		const QuaternionLanes newQ1 = ApplyRotationCorrection(q1, deltaQ1);
+		const QuaternionLanes newQ2 = ApplyRotationCorrection(q2, Set1(-1.0f) * deltaQ2);
+
+		Store(&Lambda[first], lambda + deltaLambda);
+
+		// Scatter, honouring the static flags per lane
+		alignas(32) float out[14][LANE_WIDTH];
+		Store(out[0], newP1.X); Store(out[1], newP1.Y); Store(out[2], newP1.Z);
+		Store(out[3], newP2.X); Store(out[4], newP2.Y); Store(out[5], newP2.Z);
+		Store(out[6], newQ1.X); Store(out[7], newQ1.Y); Store(out[8], newQ1.Z); Store(out[9], newQ1.W);
+		Store(out[10], newQ2.X); Store(out[11], newQ2.Y); Store(out[12], newQ2.Z); Store(out[13], newQ2.W);
+
+		const uint32_t validBits = MaskBits(valid);
+		for (uint32_t lane = 0; lane < LANE_WIDTH; ++lane)
+		{
+			if (Sources[first + lane] == INVALID_SLOT || (validBits & (1u << lane)) == 0)
+			{
+				continue;
+			}
+
+			const BodyHandle body1 = bodies1[lane];
+			const BodyHandle body2 = bodies2[lane];
+			const bool isSimulated1 = bodies.IsSimulated(body1);
+			const bool isSimulated2 = bodies.IsSimulated(body2);
+			if (isSimulated1)
+			{
+				bodies.Positions[body1] = Eigen::Vector3f(out[0][lane], out[1][lane], out[2][lane]);
+			}
+			if (isSimulated2)
+			{
+				bodies.Positions[body2] = Eigen::Vector3f(out[3][lane], out[4][lane], out[5][lane]);
+			}
+			if (isSimulated1 && bodies.CanCorrectRotation(body1))
+			{
+				bodies.Rotations[body1].coeffs() = Eigen::Vector4f(out[6][lane], out[7][lane], out[8][lane], out[9][lane]);
+				bodies.InvalidateTransformCache(body1);
+			}
+			if (isSimulated2 && bodies.CanCorrectRotation(body2))
+			{
+				bodies.Rotations[body2].coeffs() = Eigen::Vector4f(out[10][lane], out[11][lane], out[12][lane], out[13][lane]);
+				bodies.InvalidateTransformCache(body2);
+			}
+		}
+	}
+}
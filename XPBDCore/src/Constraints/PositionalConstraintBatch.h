@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	struct PositionalConstraint;
+	struct ConstraintColoring;
+
+	/**
+	* Structure-of-arrays copy of a PositionalConstraint array, solved Simd::LANE_WIDTH constraints at a time.
+	* Slots are filled color by color from a ConstraintColoring, so the constraints of a pack never share
+	* a dynamic body. Colors are padded to whole packs, padding slots are masked out by the kernel.
+	* Only XPBDBench uses it so far, the scenes have too few positional constraints to fill a pack.
+	*/
+	struct PositionalConstraintBatch
+	{
+		// Constraint each slot was built from, INVALID_SLOT for padding
+		std::vector<uint32_t> Sources;
+
+		std::vector<BodyHandle> Bodies1;
+		std::vector<BodyHandle> Bodies2;
+
+		std::vector<float> LocalR1[3];
+		std::vector<float> LocalR2[3];
+		std::vector<float> TargetDistance[3];
+		std::vector<float> Compliance;
+		std::vector<float> Lambda;
+
+		// World inverse inertia tensors (row-major), captured by the first Solve of the substep
+		std::vector<float> InvTensor1[9];
+		std::vector<float> InvTensor2[9];
+
+		// First pack of each color, with one extra entry marking the end
+		std::vector<uint32_t> ColorPackStarts;
+
+		static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+		void Build(const std::vector<PositionalConstraint>& constraints, const ConstraintColoring& coloring);
+
+		/**
+		* Resets the multipliers at the start of a substep.
+		* The first Solve afterwards captures the world inverse inertia tensors of each color right before
+		* solving it, the same point at which the scenes call GetTransformationData.
+		*/
+		void Init();
+
+		/**
+		* One solver iteration over every constraint. Colors run in sequence, the packs of a color in parallel.
+		*/
+		void Solve(BodyStore& bodies, const float substepTime);
+
+		/**
+		* Copies the accumulated multipliers back into the constraints.
+		*/
+		void StoreLambdas(std::vector<PositionalConstraint>& constraints) const;
+
+		size_t GetNumPacks() const;
+
+	private:
+		void Resize(const size_t numSlots);
+		void CaptureInverseInertia(BodyStore& bodies, const uint32_t pack);
+		void SolvePack(BodyStore& bodies, const uint32_t pack, const float substepTime);
+
+	private:
+		bool m_CaptureInverseInertia = false;
+	};
+}
@@ -0,0 +1,50 @@
+#include "RotationalConstraint.h"
+
+#include "Constraints/ConstraintKernels.h"
+#include "Constraints/TransformationData.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	void RotationalConstraint::Solve(const TransformationData& data, const float substepTime)
+	{
+		const BodyStore& bodies = *data.Bodies;
+		const Simd::Vector3T<float> deltaQ = ComputeRotationalError(ToKernel(bodies.Rotations[Body1]), ToKernel(bodies.Rotations[Body2]));
+		Solve(data, substepTime, FromKernel(deltaQ));
+	}
+
+	void RotationalConstraint::Solve(const TransformationData& data, const float substepTime, Eigen::Vector3f error)
+	{
+		const BodyStore& bodies = *data.Bodies;
+
+		const RotationalCorrection<float> correction = ComputeRotationalCorrection(ToKernel(error),
+			ToKernel(data.Body1InvTensor), ToKernel(data.Body2InvTensor), Compliance, Lambda, substepTime);
+		if (!correction.Valid)
+		{
+			return;
+		}
+
+		if (bodies.CanCorrectRotation(Body1))
+		{
+			CorrectRotation(data, Body1, FromKernel(correction.DeltaRotation1));
+		}
+
+		if (bodies.CanCorrectRotation(Body2))
+		{
+			CorrectRotation(data, Body2, FromKernel(correction.DeltaRotation2));
+		}
+		Lambda += correction.DeltaLambda;
+	}
+
+	void RotationalConstraint::SolveVelocity(BodyStore& bodies, const float substepTime) const
+	{
+		if (AngularDamping <= 0.0f || Body1 == INVALID_BODY_HANDLE || Body2 == INVALID_BODY_HANDLE)
+		{
+			return;
+		}
+
+		const float damping = std::min(AngularDamping * substepTime, 1.0f);
+		CorrectAngularVelocity(bodies, Body1, Body2, (bodies.AngularVelocities[Body1] - bodies.AngularVelocities[Body2]) * damping);
+	}
+}
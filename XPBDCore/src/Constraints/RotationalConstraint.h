@@ -0,0 +1,24 @@
+#pragma once
+#include "Constraint.h"
+
+namespace Simulation
+{
+	struct RotationalConstraint: Constraint
+	{
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+
+		// Fraction of the relative angular velocity removed per second
+		float AngularDamping = 0.0f;
+
+		void PrepareSolve(TransformationData&) const {}
+
+		void Solve(const TransformationData& data, const float substepTime);
+		void Solve(const TransformationData& data, const float substepTime, Eigen::Vector3f error);
+
+		/**
+		* Damps the relative angular velocity of the bodies, after the velocities were derived.
+		*/
+		void SolveVelocity(BodyStore& bodies, const float substepTime) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "RotationalConstraintBatch.h"
+
+#include "Constraints/ConstraintKernels.h"
+#include "Constraints/RotationalConstraint.h"
+#include "Constraints/TransformationData.h"
+#include "Simulation/ConstraintColoring.h"
+#include "Simulation/JobSystem.h"
+#include "Simulation/Simd.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	void RotationalConstraintBatch::Build(const std::vector<RotationalConstraint>& constraints, const ConstraintColoring& coloring)
+	{
+		using Simd::LANE_WIDTH;
+
+		ColorPackStarts.clear();
+		ColorPackStarts.push_back(0);
+
+		// Count the packs first so every array is sized once
+		size_t numPacks = 0;
+		for (size_t color = 0; color < coloring.GetNumColors(); ++color)
+		{
+			const uint32_t colorSize = coloring.ColorStarts[color + 1] - coloring.ColorStarts[color];
+			numPacks += (colorSize + LANE_WIDTH - 1) / LANE_WIDTH;
+		}
+		Resize(numPacks * LANE_WIDTH);
+
+		uint32_t slot = 0;
+		for (size_t color = 0; color < coloring.GetNumColors(); ++color)
+		{
+			for (uint32_t k = coloring.ColorStarts[color]; k < coloring.ColorStarts[color + 1]; ++k)
+			{
+				const uint32_t source = coloring.Order[k];
+				const RotationalConstraint& constraint = constraints[source];
+				if (constraint.Body1 == INVALID_BODY_HANDLE || constraint.Body2 == INVALID_BODY_HANDLE)
+				{
+					continue;
+				}
+
+				Sources[slot] = source;
+				Bodies1[slot] = constraint.Body1;
+				Bodies2[slot] = constraint.Body2;
+				Compliance[slot] = constraint.Compliance;
+				Lambda[slot] = constraint.Lambda;
+				++slot;
+			}
+
+			// Pad the color to a whole pack, padding slots point at body 0 and are never written back
+			slot = (slot + LANE_WIDTH - 1) / LANE_WIDTH * LANE_WIDTH;
+			ColorPackStarts.push_back(slot / LANE_WIDTH);
+		}
+	}
+
+	void RotationalConstraintBatch::Init()
+	{
+		std::fill(Lambda.begin(), Lambda.end(), 0.0f);
+		m_CaptureInverseInertia = true;
+	}
+
+	void RotationalConstraintBatch::Solve(BodyStore& bodies, const float substepTime)
+	{
+		for (size_t color = 0; color + 1 < ColorPackStarts.size(); ++color)
+		{
+			ParallelFor(ColorPackStarts[color], ColorPackStarts[color + 1], [this, &bodies, substepTime](const uint32_t pack)
+			{
+				if (m_CaptureInverseInertia)
+				{
+					CaptureInverseInertia(bodies, pack);
+				}
+				SolvePack(bodies, pack, substepTime);
+			}, 16);
+		}
+
+		m_CaptureInverseInertia = false;
+	}
+
+	void RotationalConstraintBatch::StoreLambdas(std::vector<RotationalConstraint>& constraints) const
+	{
+		for (size_t slot = 0; slot < Sources.size(); ++slot)
+		{
+			if (Sources[slot] != INVALID_SLOT)
+			{
+				constraints[Sources[slot]].Lambda = Lambda[slot];
+			}
+		}
+	}
+
+	size_t RotationalConstraintBatch::GetNumPacks() const
+	{
+		return Sources.size() / Simd::LANE_WIDTH;
+	}
+
+	void RotationalConstraintBatch::Resize(const size_t numSlots)
+	{
+		Sources.assign(numSlots, INVALID_SLOT);
+		Bodies1.assign(numSlots, 0);
+		Bodies2.assign(numSlots, 0);
+		Compliance.assign(numSlots, 0.0f);
+		Lambda.assign(numSlots, 0.0f);
+		for (int i = 0; i < 9; ++i)
+		{
+			InvTensor1[i].assign(numSlots, 0.0f);
+			InvTensor2[i].assign(numSlots, 0.0f);
+		}
+	}
+
+	void RotationalConstraintBatch::CaptureInverseInertia(BodyStore& bodies, const uint32_t pack)
+	{
+		for (uint32_t slot = pack * Simd::LANE_WIDTH; slot < (pack + 1) * Simd::LANE_WIDTH; ++slot)
+		{
+			if (Sources[slot] == INVALID_SLOT)
+			{
+				continue;
+			}
+
+			const Eigen::Matrix3f invTensor1 = ComputeWorldInverseInertia(bodies, Bodies1[slot]);
+			const Eigen::Matrix3f invTensor2 = ComputeWorldInverseInertia(bodies, Bodies2[slot]);
+			for (int i = 0; i < 9; ++i)
+			{
+				InvTensor1[i][slot] = invTensor1(i / 3, i % 3);
+				InvTensor2[i][slot] = invTensor2(i / 3, i % 3);
+			}
+		}
+	}
+
+	void RotationalConstraintBatch::SolvePack(BodyStore& bodies, const uint32_t pack, const float substepTime)
+	{
+		using namespace Simd;
+
+		const uint32_t first = pack * LANE_WIDTH;
+		const uint32_t* bodies1 = &Bodies1[first];
+		const uint32_t* bodies2 = &Bodies2[first];
+
+		// Eigen stores Quaternionf as x, y, z, w
+		const float* rotations = bodies.Rotations[0].coeffs().data();
+		const QuaternionLanes q1{ Gather(rotations, bodies1, 4, 0), Gather(rotations, bodies1, 4, 1), Gather(rotations, bodies1, 4, 2), Gather(rotations, bodies1, 4, 3) };
+		const QuaternionLanes q2{ Gather(rotations, bodies2, 4, 0), Gather(rotations, bodies2, 4, 1), Gather(rotations, bodies2, 4, 2), Gather(rotations, bodies2, 4, 3) };
+
+		Matrix3Lanes invTensor1;
+		Matrix3Lanes invTensor2;
+		for (int i = 0; i < 9; ++i)
+		{
+			invTensor1.M[i] = Load(&InvTensor1[i][first]);
+			invTensor2.M[i] = Load(&InvTensor2[i][first]);
+		}
+
+		const FloatLanes lambda = Load(&Lambda[first]);
+		const RotationalCorrection<FloatLanes> correction = ComputeRotationalCorrection(ComputeRotationalError(q1, q2),
+			invTensor1, invTensor2, Load(&Compliance[first]), lambda, Set1(substepTime));
+
+		const QuaternionLanes newQ1 = ApplyRotationCorrection(q1, correction.DeltaRotation1);
+		const QuaternionLanes newQ2 = ApplyRotationCorrection(q2, correction.DeltaRotation2);
+
+		Store(&Lambda[first], Select(correction.Valid, lambda + correction.DeltaLambda, lambda));
+
+		// Scatter, honouring the static flags per lane
+		alignas(32) float out[8][LANE_WIDTH];
+		Store(out[0], newQ1.X); Store(out[1], newQ1.Y); Store(out[2], newQ1.Z); Store(out[3], newQ1.W);
+		Store(out[4], newQ2.X); Store(out[5], newQ2.Y); Store(out[6], newQ2.Z); Store(out[7], newQ2.W);
+
+		const uint32_t validBits = MaskBits(correction.Valid);
+		for (uint32_t lane = 0; lane < LANE_WIDTH; ++lane)
+		{
+			if (Sources[first + lane] == INVALID_SLOT || (validBits & (1u << lane)) == 0)
+			{
+				continue;
+			}
+
+			if (bodies.CanCorrectRotation(bodies1[lane]))
+			{
+				bodies.Rotations[bodies1[lane]] = Eigen::Quaternionf(out[3][lane], out[0][lane], out[1][lane], out[2][lane]);
+				bodies.InvalidateTransformCache(bodies1[lane]);
+			}
+			if (bodies.CanCorrectRotation(bodies2[lane]))
+			{
+				bodies.Rotations[bodies2[lane]] = Eigen::Quaternionf(out[7][lane], out[4][lane], out[5][lane], out[6][lane]);
+				bodies.InvalidateTransformCache(bodies2[lane]);
+			}
+		}
+	}
+}
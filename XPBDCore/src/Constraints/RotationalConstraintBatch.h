@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	struct RotationalConstraint;
+	struct ConstraintColoring;
+
+	/**
+	* Structure-of-arrays copy of a RotationalConstraint array, solved Simd::LANE_WIDTH constraints at a time.
+	* Packs are laid out like PositionalConstraintBatch. The math is shared with RotationalConstraint::Solve
+	* through ConstraintKernels.h, so both paths agree bit for bit in XPBD_STRICT_FP builds.
+	*/
+	struct RotationalConstraintBatch
+	{
+		// Constraint each slot was built from, INVALID_SLOT for padding
+		std::vector<uint32_t> Sources;
+
+		std::vector<BodyHandle> Bodies1;
+		std::vector<BodyHandle> Bodies2;
+
+		std::vector<float> Compliance;
+		std::vector<float> Lambda;
+
+		// World inverse inertia tensors (row-major), captured by the first Solve of the substep
+		std::vector<float> InvTensor1[9];
+		std::vector<float> InvTensor2[9];
+
+		// First pack of each color, with one extra entry marking the end
+		std::vector<uint32_t> ColorPackStarts;
+
+		static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+		void Build(const std::vector<RotationalConstraint>& constraints, const ConstraintColoring& coloring);
+
+		/**
+		* Resets the multipliers at the start of a substep.
+		* The first Solve afterwards captures the world inverse inertia tensors of each color right before
+		* solving it, the same point at which the scenes call GetTransformationData.
+		*/
+		void Init();
+
+		/**
+		* One solver iteration over every constraint. Colors run in sequence, the packs of a color in parallel.
+		*/
+		void Solve(BodyStore& bodies, const float substepTime);
+
+		/**
+		* Copies the accumulated multipliers back into the constraints.
+		*/
+		void StoreLambdas(std::vector<RotationalConstraint>& constraints) const;
+
+		size_t GetNumPacks() const;
+
+	private:
+		void Resize(const size_t numSlots);
+		void CaptureInverseInertia(BodyStore& bodies, const uint32_t pack);
+		void SolvePack(BodyStore& bodies, const uint32_t pack, const float substepTime);
+
+	private:
+		bool m_CaptureInverseInertia = false;
+	};
+}
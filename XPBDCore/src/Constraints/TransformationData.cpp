@@ -0,0 +1,158 @@
+#include "TransformationData.h"
+#include "Constraints/PositionalConstraint.h"
+#include "Constraints/ConstraintKernels.h"
+#include "Simulation/JacobiCorrections.h"
+
+#include <cfloat>
+
+namespace Simulation
+{
+    const Eigen::Matrix3f& ComputeWorldInverseInertia(BodyStore &bodies, BodyHandle body)
+    {
+        return bodies.GetWorldInverseInertia(body);
+    }
+
+    TransformationData GetTransformationData(BodyStore &bodies, BodyHandle b1, BodyHandle b2)
+    {
+        TransformationData data;
+
+        data.Bodies = &bodies;
+        data.Body1 = b1;
+        data.Body2 = b2;
+
+        data.Body1InvTensor = ComputeWorldInverseInertia(bodies, b1);
+        data.Body2InvTensor = ComputeWorldInverseInertia(bodies, b2);
+
+        return data;
+    }
+
+    void ComputePositionalData(TransformationData &data, const Eigen::Vector3f& localR1, const Eigen::Vector3f& localR2)
+    {
+        data.WorldR1 = data.Bodies->GetRotationMatrix(data.Body1) * localR1;
+        data.WorldR2 = data.Bodies->GetRotationMatrix(data.Body2) * localR2;
+    }
+
+    void CorrectPosition(const TransformationData &data, BodyHandle body, const Eigen::Vector3f& deltaPosition)
+    {
+        if (data.Correction)
+        {
+            (body == data.Body1 ? data.Correction->Position1 : data.Correction->Position2) += deltaPosition;
+            return;
+        }
+
+        // Sleeping bodies act as static until their island wakes up
+        if (data.Bodies->IsSimulated(body))
+        {
+            data.Bodies->Positions[body] += deltaPosition;
+        }
+    }
+
+    void CorrectRotation(const TransformationData &data, BodyHandle body, const Eigen::Vector3f& deltaRotation)
+    {
+        using namespace Eigen;
+        if (data.Correction)
+        {
+            (body == data.Body1 ? data.Correction->Rotation1 : data.Correction->Rotation2) += deltaRotation;
+            return;
+        }
+
+        if (!data.Bodies->IsSimulated(body))
+        {
+            return;
+        }
+
+        // Same arithmetic as the batched kernels, see ConstraintKernels.h
+        Quaternionf& rotation = data.Bodies->Rotations[body];
+        rotation = FromKernel(Simd::ApplyRotationCorrection(ToKernel(rotation), ToKernel(deltaRotation)));
+        data.Bodies->InvalidateTransformCache(body);
+    }
+
+    float GetGeneralizedInverseMass(const BodyStore &bodies, BodyHandle body, const Eigen::Matrix3f& invInertia, const Eigen::Vector3f& r, const Eigen::Vector3f& n)
+    {
+        if (!bodies.IsSimulated(body))
+        {
+            return 0.0f;
+        }
+
+        float inverseMass = bodies.InverseMasses[body];
+        if (bodies.CanCorrectRotation(body))
+        {
+            const Eigen::Vector3f rCrossN = r.cross(n);
+            inverseMass += rCrossN.dot(invInertia * rCrossN);
+        }
+        return inverseMass;
+    }
+
+    void CorrectVelocity(BodyStore &bodies, BodyHandle b1, BodyHandle b2, const Eigen::Vector3f& r1, const Eigen::Vector3f& r2, const Eigen::Vector3f& deltaV)
+    {
+        using namespace Eigen;
+        const float deltaSpeed = deltaV.norm();
+        if (deltaSpeed <= FLT_EPSILON)
+        {
+            return;
+        }
+
+        const Vector3f direction = deltaV / deltaSpeed;
+        const Matrix3f& invInertia1 = bodies.GetWorldInverseInertia(b1);
+        const Matrix3f& invInertia2 = bodies.GetWorldInverseInertia(b2);
+        const float w1 = GetGeneralizedInverseMass(bodies, b1, invInertia1, r1, direction);
+        const float w2 = GetGeneralizedInverseMass(bodies, b2, invInertia2, r2, direction);
+        if (w1 + w2 <= FLT_EPSILON)
+        {
+            return;
+        }
+
+        // Impulse on b2, b1 receives the opposite one.
+        const Vector3f impulse = deltaV / (w1 + w2);
+        if (bodies.IsSimulated(b1))
+        {
+            bodies.LinearVelocities[b1] -= bodies.InverseMasses[b1] * impulse;
+            if (bodies.CanCorrectRotation(b1))
+            {
+                bodies.AngularVelocities[b1] -= invInertia1 * r1.cross(impulse);
+            }
+        }
+
+        if (bodies.IsSimulated(b2))
+        {
+            bodies.LinearVelocities[b2] += bodies.InverseMasses[b2] * impulse;
+            if (bodies.CanCorrectRotation(b2))
+            {
+                bodies.AngularVelocities[b2] += invInertia2 * r2.cross(impulse);
+            }
+        }
+    }
+
+    void CorrectAngularVelocity(BodyStore &bodies, BodyHandle b1, BodyHandle b2, const Eigen::Vector3f& deltaOmega)
+    {
+        using namespace Eigen;
+        const float deltaSpeed = deltaOmega.norm();
+        if (deltaSpeed <= FLT_EPSILON)
+        {
+            return;
+        }
+
+        const Vector3f axis = deltaOmega / deltaSpeed;
+        const Matrix3f& invInertia1 = bodies.GetWorldInverseInertia(b1);
+        const Matrix3f& invInertia2 = bodies.GetWorldInverseInertia(b2);
+        const bool canRotate1 = bodies.IsSimulated(b1) && bodies.CanCorrectRotation(b1);
+        const bool canRotate2 = bodies.IsSimulated(b2) && bodies.CanCorrectRotation(b2);
+        const float w1 = canRotate1 ? axis.dot(invInertia1 * axis) : 0.0f;
+        const float w2 = canRotate2 ? axis.dot(invInertia2 * axis) : 0.0f;
+        if (w1 + w2 <= FLT_EPSILON)
+        {
+            return;
+        }
+
+        const Vector3f angularImpulse = deltaOmega / (w1 + w2);
+        if (canRotate1)
+        {
+            bodies.AngularVelocities[b1] -= invInertia1 * angularImpulse;
+        }
+
+        if (canRotate2)
+        {
+            bodies.AngularVelocities[b2] += invInertia2 * angularImpulse;
+        }
+    }
+}
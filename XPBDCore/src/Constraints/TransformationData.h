@@ -0,0 +1,57 @@
+#pragma once
+#include <Eigen/Dense>
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+    struct ConstraintCorrection;
+
+    struct TransformationData
+    {
+        BodyStore *Bodies = nullptr;
+        BodyHandle Body1 = INVALID_BODY_HANDLE;
+        BodyHandle Body2 = INVALID_BODY_HANDLE;
+
+        Eigen::Vector3f WorldR1;
+        Eigen::Vector3f WorldR2;
+
+        Eigen::Matrix3f Body1InvTensor;
+        Eigen::Matrix3f Body2InvTensor;
+
+        // When set, corrections are recorded here for a Jacobi solve instead of being applied to the bodies.
+        ConstraintCorrection* Correction = nullptr;
+    };
+
+    /**
+    * Inverse inertia tensor of the body in world space, R * I^-1 * R^T.
+    * Read from the body transform cache.
+    */
+    const Eigen::Matrix3f& ComputeWorldInverseInertia(BodyStore &bodies, BodyHandle body);
+
+    TransformationData GetTransformationData(BodyStore &bodies, BodyHandle b1, BodyHandle b2);
+    void ComputePositionalData(TransformationData &data, const Eigen::Vector3f& localR1, const Eigen::Vector3f& localR2);
+
+    /**
+    * Moves the body by deltaPosition, or records the move when the data targets a Jacobi correction.
+    */
+    void CorrectPosition(const TransformationData &data, BodyHandle body, const Eigen::Vector3f& deltaPosition);
+    /**
+    * Rotates the body by q += 0.5 * [deltaRotation, 0] * q, or records it for a Jacobi correction.
+    */
+    void CorrectRotation(const TransformationData &data, BodyHandle body, const Eigen::Vector3f& deltaRotation);
+
+    /**
+    * Inverse mass of the body seen at r along the unit direction n, zero for static bodies.
+    */
+    float GetGeneralizedInverseMass(const BodyStore &bodies, BodyHandle body, const Eigen::Matrix3f& invInertia, const Eigen::Vector3f& r, const Eigen::Vector3f& n);
+
+    /**
+    * Changes the relative velocity v2 - v1 of the points at r1 and r2 by deltaV, through opposite impulses
+    * split by the generalized inverse masses. Used by the velocity passes, static bodies keep their velocity.
+    */
+    void CorrectVelocity(BodyStore &bodies, BodyHandle b1, BodyHandle b2, const Eigen::Vector3f& r1, const Eigen::Vector3f& r2, const Eigen::Vector3f& deltaV);
+    /**
+    * Changes the relative angular velocity w2 - w1 by deltaOmega, through opposite angular impulses.
+    */
+    void CorrectAngularVelocity(BodyStore &bodies, BodyHandle b1, BodyHandle b2, const Eigen::Vector3f& deltaOmega);
+}
@@ -0,0 +1,68 @@
+#include "VolumeConstraint.h"
+
+#include <cfloat>
+
+namespace Simulation
+{
+	static float ComputeVolume6(const BodyStore& bodies, const BodyHandle (&handles)[4])
+	{
+		const Eigen::Vector3f x2_minus_x1 = bodies.Positions[handles[1]] - bodies.Positions[handles[0]];
+		const Eigen::Vector3f x3_minus_x1 = bodies.Positions[handles[2]] - bodies.Positions[handles[0]];
+		const Eigen::Vector3f x4_minus_x1 = bodies.Positions[handles[3]] - bodies.Positions[handles[0]];
+		return (x2_minus_x1.cross(x3_minus_x1)).dot(x4_minus_x1);
+	}
+
+	void VolumeConstraint::SetRestVolume(const BodyStore& bodies)
+	{
+		TargetVolume = ComputeVolume6(bodies, Bodies) / 6.0f;
+	}
+
+	void VolumeConstraint::Solve(BodyStore& bodies, const float substepTime)
+	{
+		for (const BodyHandle body : Bodies)
+		{
+			if (body == INVALID_BODY_HANDLE)
+			{
+				return;
+			}
+		}
+
+		const Eigen::Vector3f x2_minus_x1 = bodies.Positions[Bodies[1]] - bodies.Positions[Bodies[0]];
+		const Eigen::Vector3f x3_minus_x1 = bodies.Positions[Bodies[2]] - bodies.Positions[Bodies[0]];
+		const Eigen::Vector3f x4_minus_x1 = bodies.Positions[Bodies[3]] - bodies.Positions[Bodies[0]];
+		const Eigen::Vector3f x3_minus_x2 = bodies.Positions[Bodies[2]] - bodies.Positions[Bodies[1]];
+		const Eigen::Vector3f x4_minus_x2 = bodies.Positions[Bodies[3]] - bodies.Positions[Bodies[1]];
+
+		const float currentVolume = (x2_minus_x1.cross(x3_minus_x1)).dot(x4_minus_x1);
+		const float deltaVolume = currentVolume - 6 * TargetVolume;
+
+		const Eigen::Vector3f dC[4] = {
+			x4_minus_x2.cross(x3_minus_x2),
+			x3_minus_x1.cross(x4_minus_x1),
+			x4_minus_x1.cross(x2_minus_x1),
+			x2_minus_x1.cross(x3_minus_x1)
+		};
+
+		float inverseMasses[4];
+		float denom = 0.0f;
+		for (int i = 0; i < 4; ++i)
+		{
+			inverseMasses[i] = !bodies.IsSimulated(Bodies[i]) ? 0.0f : bodies.InverseMasses[Bodies[i]];
+			denom += inverseMasses[i] * (dC[i].dot(dC[i]));
+		}
+
+		const float alphaTilde = Compliance / (substepTime * substepTime);
+		denom += alphaTilde;
+		if (denom <= FLT_EPSILON)
+		{
+			return;
+		}
+
+		const float deltaLambda = (-deltaVolume - alphaTilde * Lambda) / denom;
+		for (int i = 0; i < 4; ++i)
+		{
+			bodies.Positions[Bodies[i]] += (inverseMasses[i] * deltaLambda) * dC[i];
+		}
+		Lambda += deltaLambda;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include "Constraint.h"
+
+namespace Simulation
+{
+	/**
+	* Keeps the signed volume of the tetrahedron spanned by four bodies at its rest value.
+	* Only moves positions, so it works on particles as well as rigid bodies.
+	*/
+	struct VolumeConstraint: Constraint
+	{
+		BodyHandle Bodies[4] = { INVALID_BODY_HANDLE, INVALID_BODY_HANDLE, INVALID_BODY_HANDLE, INVALID_BODY_HANDLE };
+		float TargetVolume = 0.0f;
+
+		/**
+		* Sets TargetVolume to the current volume of the tetrahedron.
+		*/
+		void SetRestVolume(const BodyStore& bodies);
+
+		void Solve(BodyStore& bodies, const float substepTime);
+	};
+}
\ No newline at end of file
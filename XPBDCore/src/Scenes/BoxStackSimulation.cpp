@@ -0,0 +1,140 @@
+#include "BoxStackSimulation.h"
+#include "Collision/Narrowphase.h"
+#include "Simulation/JobSystem.h"
+
+#include <cmath>
+
+namespace Simulation
+{
+	BoxStackSimulation::BoxStackSimulation()
+	{
+		BodyDesc bodyDesc;
+		bodyDesc.InverseMass = 1.0f;
+		bodyDesc.InertiaTensor = ComputeInertiaTensorForCube(1.0f, 1.0f, 1.0f);
+		bodyDesc.BodyCollider.Type = ColliderType::Box;
+
+		const BodyHandle ground = AddEntity(bodyDesc, Eigen::Vector3f(0.0f, -0.5f, 0.0f), Eigen::Vector3f(12.0f, 1.0f, 12.0f));
+		m_Bodies.SetFlag(ground, BODY_FLAG_STATIC, true);
+
+		// Small gaps, so the boxes settle onto each other instead of starting in contact
+		for (int i = 0; i < STACK_HEIGHT; ++i)
+		{
+			AddEntity(bodyDesc, Eigen::Vector3f(-2.0f, 0.5f + 1.01f * i, 0.0f));
+		}
+
+		for (int row = 0; row < PYRAMID_BASE; ++row)
+		{
+			for (int i = 0; i < PYRAMID_BASE - row; ++i)
+			{
+				AddEntity(bodyDesc, Eigen::Vector3f(2.0f + 1.05f * (i + 0.5f * row), 0.5f + 1.01f * row, 0.0f));
+			}
+		}
+
+		Reset();
+	}
+
+	void BoxStackSimulation::OnStartSimulationFrame()
+	{
+		AddGravity(m_Gravity);
+	}
+
+	void BoxStackSimulation::OnDetectCollisions(const float)
+	{
+		m_Broadphase.Update(m_Bodies);
+		CollidePairs(m_Bodies, m_Broadphase.GetPairs(), m_Contacts, &m_GjkCaches);
+
+		// The contact set changes every substep, so the Jacobi incidence and the island groups are rebuilt with it.
+		m_Constraints.SetContacts(m_Bodies, m_Contacts, m_Material);
+		if (m_EnableSleeping)
+		{
+			m_Constraints.WakeIslands(m_Bodies, m_Islands);
+		}
+
+		if (IsIslandParallel())
+		{
+			m_Constraints.PartitionIslands(m_Bodies, m_Islands);
+			m_Constraints.GetIslandConstraintCounts(m_IslandConstraintCounts);
+			m_Schedule.Build(m_Bodies, m_Islands, m_IslandConstraintCounts, GetNumPosIterations());
+		}
+		else
+		{
+			m_Constraints.Prepare(m_Bodies, GetSolverMode());
+		}
+	}
+
+	void BoxStackSimulation::OnSolveConstraints(const float substepTime)
+	{
+		m_ConstraintSolves += m_Constraints.Size() * GetNumPosIterations();
+		if (!IsIslandParallel())
+		{
+			for (int i = 0; i < GetNumPosIterations(); ++i)
+			{
+				m_Constraints.Solve(m_Bodies, i, substepTime, GetSolverMode(), GetRelaxation());
+			}
+			return;
+		}
+
+		// Every island runs all of its iterations in one job, then the contacts bridging islands are solved on their own.
+		BodyStore& bodies = m_Bodies;
+		const int numIterations = GetNumPosIterations();
+		RunIslands(m_Schedule, [&](const uint32_t island)
+		{
+			for (int i = 0; i < numIterations; ++i)
+			{
+				m_Constraints.SolveIsland(bodies, island, i, substepTime);
+			}
+		});
+
+		for (int i = 0; i < numIterations; ++i)
+		{
+			m_Constraints.SolveIsland(bodies, m_Constraints.GetSharedIsland(), i, substepTime);
+		}
+	}
+
+	void BoxStackSimulation::OnSolveVelocities(const float substepTime)
+	{
+		m_Bodies.ApplyDamping(substepTime);
+
+		// Approach speeds gained from gravity within a couple of substeps do not bounce.
+		const float restitutionThreshold = 2.0f * std::abs(m_Gravity) * substepTime;
+		if (IsIslandParallel())
+		{
+			BodyStore& bodies = m_Bodies;
+			RunIslands(m_Schedule, [&](const uint32_t island)
+			{
+				m_Constraints.SolveIslandVelocities(bodies, island, substepTime, restitutionThreshold);
+			});
+			m_Constraints.SolveIslandVelocities(bodies, m_Constraints.GetSharedIsland(), substepTime, restitutionThreshold);
+		}
+		else
+		{
+			m_Constraints.SolveVelocities(m_Bodies, substepTime, restitutionThreshold);
+		}
+
+		m_FrameTime += substepTime;
+	}
+
+	void BoxStackSimulation::OnEndSimulationFrame()
+	{
+		m_Bodies.ClearForces();
+
+		// Joints and the contacts of the last substep link the bodies into islands.
+		if (m_EnableSleeping || IsIslandParallel())
+		{
+			m_IslandLinks.clear();
+			m_Constraints.GetBodyPairs(m_IslandLinks);
+			m_Islands.Build(m_Bodies, m_IslandLinks);
+		}
+
+		if (m_EnableSleeping)
+		{
+			m_Islands.UpdateSleeping(m_Bodies, m_FrameTime, m_SleepSettings);
+		}
+		m_FrameTime = 0.0f;
+	}
+
+	bool BoxStackSimulation::IsIslandParallel() const
+	{
+		return m_IslandParallel && GetSolverMode() == SolverMode::GaussSeidel;
+	}
+}
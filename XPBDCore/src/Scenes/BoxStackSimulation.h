@@ -0,0 +1,58 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/SweepAndPrune.h"
+#include "Constraints/ConstraintRegistry.h"
+#include "Simulation/IslandSchedule.h"
+#include "Simulation/Islands.h"
+
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* A column and a pyramid of boxes resting on a static ground box, held up only by contacts.
+	*/
+	class BoxStackSimulation : public SceneSimulation
+	{
+	public:
+		BoxStackSimulation();
+
+	protected:
+		void OnStartSimulationFrame() override;
+
+		void OnDetectCollisions(const float substepTime) override;
+
+		void OnSolveConstraints(const float substepTime) override;
+
+		void OnSolveVelocities(const float substepTime) override;
+
+		void OnEndSimulationFrame() override;
+
+		// Islands only split the Gauss-Seidel solve, Jacobi already runs every constraint in parallel.
+		bool IsIslandParallel() const;
+
+	protected:
+		static constexpr int STACK_HEIGHT = 6;
+		static constexpr int PYRAMID_BASE = 3;
+
+		// Only holds the contacts, rebuilt from the manifolds every substep
+		ConstraintRegistry m_Constraints;
+		ContactMaterial m_Material;
+
+		SweepAndPrune m_Broadphase;
+
+		BodyIslands m_Islands;
+		std::vector<ConstraintBodies> m_IslandLinks;
+		std::vector<uint32_t> m_IslandConstraintCounts;
+		IslandSchedule m_Schedule;
+
+		float m_Gravity = -10.0f;
+
+		SleepSettings m_SleepSettings;
+		bool m_EnableSleeping = true;
+		bool m_IslandParallel = true;
+		// Simulated time of the current frame, summed over the substeps
+		float m_FrameTime = 0.0f;
+	};
+}
@@ -0,0 +1,80 @@
+#include "CubeHingeSimulation.h"
+#include "Collision/Narrowphase.h"
+
+#include <cmath>
+
+namespace Simulation
+{
+	CubeHingeSimulation::CubeHingeSimulation()
+	{
+		BodyDesc bodyDesc;
+		bodyDesc.InverseMass = 1.0f;
+		bodyDesc.InertiaTensor = ComputeInertiaTensorForCube(1.0f, 1.0f, 1.0f);
+		bodyDesc.BodyCollider.Type = ColliderType::Box;
+
+		const BodyHandle anchor = AddEntity(bodyDesc, Eigen::Vector3f(0.0f, 6.0f, 0.0f), Eigen::Vector3f(0.25f, 0.25f, 0.25f));
+		m_Bodies.SetFlag(anchor, BODY_FLAG_STATIC, true);
+		const BodyHandle arm = AddEntity(bodyDesc, Eigen::Vector3f(0.0f, 4.25f, 0.0f), Eigen::Vector3f(0.25f, 3.0f, 0.25f));
+		const BodyHandle tip = AddEntity(bodyDesc, Eigen::Vector3f(0.0f, 2.25f, 0.0f), Eigen::Vector3f(0.25f, 1.0f, 0.25f));
+
+		const std::array<BodyHandle, 3> chain = { anchor, arm, tip };
+		const std::array<Eigen::Vector3f, 2> attachPoints1 = { Eigen::Vector3f(0.0f, -0.25f, 0.0f), Eigen::Vector3f(0.0f, -1.5f, 0.0f) };
+		const std::array<Eigen::Vector3f, 2> attachPoints2 = { Eigen::Vector3f(0.0f, 1.5f, 0.0f), Eigen::Vector3f(0.0f, 0.5f, 0.0f) };
+		for (size_t i = 0; i < attachPoints1.size(); ++i)
+		{
+			HingeConstraint hinge;
+			hinge.Compliance = 0.001f;
+			hinge.Body1 = chain[i];
+			hinge.Body2 = chain[i + 1];
+
+			hinge.E1AlignAxis = Eigen::Vector3f(0.0f, 0.0f, 1.0f);
+			hinge.E2AlignAxis = Eigen::Vector3f(0.0f, 0.0f, 1.0f);
+
+			hinge.E1LimitAxis = Eigen::Vector3f(0.0f, 0.0f, 1.0f);
+			hinge.E2LimitAxis = Eigen::Vector3f(0.0f, 0.0f, 1.0f);
+
+			hinge.E1AttachPoint = attachPoints1[i];
+			hinge.E2AttachPoint = attachPoints2[i];
+			m_Constraints.Add(hinge);
+			IgnoreCollisions(hinge.Body1, hinge.Body2);
+		}
+
+		Reset();
+	}
+
+	void CubeHingeSimulation::OnStartSimulationFrame()
+	{
+		AddGravity(m_Gravity);
+	}
+
+	void CubeHingeSimulation::OnDetectCollisions(const float)
+	{
+		m_Broadphase.Update(m_Bodies);
+		CollidePairs(m_Bodies, FilterPairs(m_Broadphase.GetPairs()), m_Contacts, &m_GjkCaches);
+
+		// The contacts change every substep, so the Jacobi incidence is rebuilt with them.
+		m_Constraints.SetContacts(m_Bodies, m_Contacts, m_Material);
+		m_Constraints.Prepare(m_Bodies, GetSolverMode());
+	}
+
+	void CubeHingeSimulation::OnSolveConstraints(const float substepTime)
+	{
+		for (int i = 0; i < GetNumPosIterations(); ++i)
+		{
+			m_Constraints.Solve(m_Bodies, i, substepTime, GetSolverMode(), GetRelaxation());
+		}
+		m_ConstraintSolves += m_Constraints.Size() * GetNumPosIterations();
+	}
+
+	void CubeHingeSimulation::OnSolveVelocities(const float substepTime)
+	{
+		// Approach speeds gained from gravity within a couple of substeps do not bounce.
+		const float restitutionThreshold = 2.0f * std::abs(m_Gravity) * substepTime;
+		m_Constraints.SolveVelocities(m_Bodies, substepTime, restitutionThreshold);
+	}
+
+	void CubeHingeSimulation::OnEndSimulationFrame()
+	{
+		m_Bodies.ClearForces();
+	}
+}
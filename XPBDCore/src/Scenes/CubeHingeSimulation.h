@@ -0,0 +1,39 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/SweepAndPrune.h"
+#include "Constraints/ConstraintRegistry.h"
+
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* Two boxes swinging from a static anchor on a chain of two hinges.
+	*/
+	class CubeHingeSimulation : public SceneSimulation
+	{
+	public:
+		CubeHingeSimulation();
+
+	protected:
+		void OnStartSimulationFrame() override;
+
+		void OnDetectCollisions(const float substepTime) override;
+
+		void OnSolveConstraints(const float substepTime) override;
+
+		void OnSolveVelocities(const float substepTime) override;
+
+		void OnEndSimulationFrame() override;
+
+	protected:
+		// The hinges and the contacts, rebuilt from the manifolds every substep
+		ConstraintRegistry m_Constraints;
+		ContactMaterial m_Material;
+
+		SweepAndPrune m_Broadphase;
+
+		float m_Gravity = -10.0f;
+	};
+}
@@ -0,0 +1,78 @@
+#include "CubePositionalSimulation.h"
+#include "Collision/Narrowphase.h"
+
+#include <cmath>
+
+namespace Simulation
+{
+	CubePositionalSimulation::CubePositionalSimulation()
+	{
+		BodyDesc anchorDesc;
+		anchorDesc.IsStaticBody = true;
+		anchorDesc.InverseMass = 1.0f;
+		anchorDesc.InertiaTensor = ComputeInertiaTensorForCube(0.1f, 0.1f, 0.1f);
+		anchorDesc.BodyCollider.Type = ColliderType::Box;
+		const BodyHandle anchor = AddEntity(anchorDesc, Eigen::Vector3f(0.0f, 4.0f, 0.0f), 0.25f * Eigen::Vector3f::Ones());
+
+		BodyDesc cubeDesc;
+		cubeDesc.InverseMass = 1.0f;
+		cubeDesc.InertiaTensor = ComputeInertiaTensorForCube(1.0f, 1.0f, 1.0f);
+		cubeDesc.BodyCollider.Type = ColliderType::Box;
+		const BodyHandle cube = AddEntity(cubeDesc, Eigen::Vector3f(0.0f, 2.0f, 0.0f));
+
+		m_Constraint.Body1 = cube;
+		m_Constraint.LocalR1 = Eigen::Vector3f(0.25f, 0.5f, 0.0f);
+		m_Constraint.Body2 = anchor;
+		m_Constraint.Compliance = 0.0f;
+		m_Constraint.TargetDistance = Eigen::Vector3f(0.0f, -2.0f, 0.0f);
+
+		Reset();
+	}
+
+	void CubePositionalSimulation::OnStartSimulationFrame()
+	{
+		if (m_EnableGravity)
+		{
+			AddGravity(m_Gravity);
+		}
+	}
+
+	void CubePositionalSimulation::OnDetectCollisions(const float)
+	{
+		m_Broadphase.Update(m_Bodies);
+		CollidePairs(m_Bodies, FilterPairs(m_Broadphase.GetPairs()), m_Contacts, &m_GjkCaches);
+
+		m_ContactConstraints.SetContacts(m_Bodies, m_Contacts, m_Material);
+		m_ContactConstraints.Prepare(m_Bodies, GetSolverMode());
+	}
+
+	void CubePositionalSimulation::OnSolveConstraints(const float substepTime)
+	{
+		for (int i = 0; i < GetNumPosIterations(); ++i)
+		{
+			if (i == 0)
+			{
+				m_Constraint.Init();
+				m_TransformationData = GetTransformationData(m_Bodies, m_Constraint.Body1, m_Constraint.Body2);
+			}
+
+			ComputePositionalData(m_TransformationData, m_Constraint.LocalR1, m_Constraint.LocalR2);
+			m_Constraint.Solve(m_TransformationData, substepTime);
+
+			m_ContactConstraints.Solve(m_Bodies, i, substepTime, GetSolverMode(), GetRelaxation());
+		}
+		m_ConstraintSolves += (1 + m_ContactConstraints.Size()) * GetNumPosIterations();
+	}
+
+	void CubePositionalSimulation::OnSolveVelocities(const float substepTime)
+	{
+		// Approach speeds gained from gravity within a couple of substeps do not bounce.
+		const float restitutionThreshold = 2.0f * std::abs(m_Gravity) * substepTime;
+		m_ContactConstraints.SolveVelocities(m_Bodies, substepTime, restitutionThreshold);
+	}
+
+	void CubePositionalSimulation::OnEndSimulationFrame()
+	{
+		m_Bodies.ClearForces();
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/SweepAndPrune.h"
+#include "Constraints/ConstraintRegistry.h"
+#include "Constraints/PositionalConstraint.h"
+#include "Constraints/TransformationData.h"
+
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* A cube hanging from a static anchor on one distance constraint.
+	*/
+	class CubePositionalSimulation : public SceneSimulation
+	{
+	public:
+		CubePositionalSimulation();
+
+	protected:
+		void OnStartSimulationFrame() override;
+
+		void OnDetectCollisions(const float substepTime) override;
+
+		void OnSolveConstraints(const float substepTime) override;
+
+		void OnSolveVelocities(const float substepTime) override;
+
+		void OnEndSimulationFrame() override;
+
+	protected:
+		PositionalConstraint m_Constraint;
+		TransformationData m_TransformationData;
+
+		SweepAndPrune m_Broadphase;
+		// Only holds the contacts, rebuilt from the manifolds every substep
+		ConstraintRegistry m_ContactConstraints;
+		ContactMaterial m_Material;
+
+		float m_Gravity = -9.8f;
+		bool m_EnableGravity = true;
+	};
+}
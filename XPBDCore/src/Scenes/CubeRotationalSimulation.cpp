@@ -0,0 +1,49 @@
+#include "CubeRotationalSimulation.h"
+
+namespace Simulation
+{
+	CubeRotationalSimulation::CubeRotationalSimulation()
+	{
+		BodyDesc bodyDesc0;
+		bodyDesc0.InverseMass = 1.0f;
+		bodyDesc0.InertiaTensor = ComputeInertiaTensorForCube(1.0f, 1.0f, 1.0f);
+		m_Constraint.Body1 = AddEntity(bodyDesc0, Eigen::Vector3f(-1.0f, 2.0f, 0.0f));
+
+		BodyDesc bodyDesc1;
+		bodyDesc1.InverseMass = 1.0f;
+		bodyDesc1.InertiaTensor = ComputeInertiaTensorForCube(0.1f, 0.1f, 0.1f);
+		m_Constraint.Body2 = AddEntity(bodyDesc1, Eigen::Vector3f(1.0f, 2.0f, 0.0f));
+
+		m_Constraint.Compliance = 0.001f;
+
+		Reset();
+	}
+
+	void CubeRotationalSimulation::OnStartSimulationFrame()
+	{
+	}
+
+	void CubeRotationalSimulation::OnSolveConstraints(const float substepTime)
+	{
+		for (int i = 0; i < GetNumPosIterations(); ++i)
+		{
+			if (i == 0)
+			{
+				m_Constraint.Lambda = 0.0f;
+				m_TransformationData = GetTransformationData(m_Bodies, m_Constraint.Body1, m_Constraint.Body2);
+			}
+
+			const Eigen::Vector3f world1X = m_Bodies.Rotations[m_Constraint.Body1].toRotationMatrix() * Eigen::Vector3f(1.0f, 0.0f, 0.0f);
+			const Eigen::Vector3f world2X = m_Bodies.Rotations[m_Constraint.Body2].toRotationMatrix() * Eigen::Vector3f(1.0f, 0.0f, 0.0f);
+			const Eigen::Vector3f deltaQ = world1X.cross(world2X);
+
+			m_Constraint.Solve(m_TransformationData, substepTime, deltaQ);
+		}
+		m_ConstraintSolves += GetNumPosIterations();
+	}
+
+	void CubeRotationalSimulation::OnEndSimulationFrame()
+	{
+		m_Bodies.ClearForces();
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+#include "Constraints/RotationalConstraint.h"
+#include "Constraints/TransformationData.h"
+
+namespace Simulation
+{
+	/**
+	* Two free cubes whose x axes are pulled into line by one rotational constraint.
+	*/
+	class CubeRotationalSimulation : public SceneSimulation
+	{
+	public:
+		CubeRotationalSimulation();
+
+	protected:
+		void OnStartSimulationFrame() override;
+
+		void OnSolveConstraints(const float substepTime) override;
+
+		void OnEndSimulationFrame() override;
+
+	protected:
+		RotationalConstraint m_Constraint;
+		TransformationData m_TransformationData;
+	};
+}
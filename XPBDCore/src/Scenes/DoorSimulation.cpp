@@ -0,0 +1,99 @@
+#include "DoorSimulation.h"
+#include "Collision/Narrowphase.h"
+
+#include <cmath>
+
+namespace Simulation
+{
+	namespace
+	{
+		constexpr float DEGREES_TO_RADIANS = 3.14159265358979323846f / 180.0f;
+	}
+
+	DoorSimulation::DoorSimulation()
+	{
+		BodyDesc bodyDesc;
+		bodyDesc.InverseMass = 1.0f;
+		bodyDesc.InertiaTensor = ComputeInertiaTensorForCube(1.0f, 1.0f, 1.0f);
+		bodyDesc.BodyCollider.Type = ColliderType::Box;
+
+		const BodyHandle frame = AddEntity(bodyDesc, Eigen::Vector3f(0.0f, 1.5f, 0.0f), Eigen::Vector3f(0.25f, 2.0f, 0.25f));
+		m_Bodies.SetFlag(frame, BODY_FLAG_STATIC, true);
+
+		const BodyHandle door = AddEntity(bodyDesc, Eigen::Vector3f(0.5f, 1.5f, 0.0f), Eigen::Vector3f(1.0f, 2.0f, 0.125f));
+
+		const BodyHandle stop = AddEntity(bodyDesc, Eigen::Vector3f(1.0f, 1.5f, 3.0f), Eigen::Vector3f(0.25f, 0.25f, 0.25f));
+		m_Bodies.SetFlag(stop, BODY_FLAG_STATIC, true);
+
+		HingeConstraint hingeConstraint;
+		hingeConstraint.Compliance = 0.0f;
+		hingeConstraint.Body1 = frame;
+		hingeConstraint.Body2 = door;
+
+		hingeConstraint.E1AlignAxis = Eigen::Vector3f(0.0f, 1.0f, 0.0f);
+		hingeConstraint.E2AlignAxis = Eigen::Vector3f(0.0f, 1.0f, 0.0f);
+
+		hingeConstraint.E1LimitAxis = Eigen::Vector3f(1.0f, 0.0f, 0.0f);
+		hingeConstraint.E2LimitAxis = Eigen::Vector3f(1.0f, 0.0f, 0.0f);
+
+		hingeConstraint.LimitAngle = true;
+		hingeConstraint.LimitAngleMin = 0.0f;
+		hingeConstraint.LimitAngleMax = 90.0f * DEGREES_TO_RADIANS;
+
+		hingeConstraint.E1AttachPoint = Eigen::Vector3f(0.0f, 0.0f, 0.0f);
+		hingeConstraint.E2AttachPoint = Eigen::Vector3f(-0.5f, 0.0f, 0.0f);
+		hingeConstraint.AngularDamping = 1.0f;
+		m_Constraints.Add(hingeConstraint);
+		IgnoreCollisions(frame, door);
+
+		// Measured before the bodies are reset, while they all still sit at the origin, so the stop pulls the door edge all the way onto it.
+		PositionalConstraint positionalConstraint;
+		positionalConstraint.Body1 = stop;
+		positionalConstraint.Body2 = door;
+		positionalConstraint.LocalR1 = Eigen::Vector3f(0.0f, 0.0f, 0.0f);
+		positionalConstraint.LocalR2 = Eigen::Vector3f(0.5f, 0.0f, 0.0f);
+		positionalConstraint.TargetDistance = m_Bodies.Positions[door] - m_Bodies.Positions[stop];
+		positionalConstraint.Compliance = 0.5f;
+		m_Constraints.Add(positionalConstraint);
+
+		Reset();
+	}
+
+	void DoorSimulation::OnStartSimulationFrame()
+	{
+		AddGravity(m_Gravity);
+	}
+
+	void DoorSimulation::OnDetectCollisions(const float)
+	{
+		m_Broadphase.Update(m_Bodies);
+		CollidePairs(m_Bodies, FilterPairs(m_Broadphase.GetPairs()), m_Contacts, &m_GjkCaches);
+
+		// The contacts change every substep, so the Jacobi incidence is rebuilt with them.
+		m_Constraints.SetContacts(m_Bodies, m_Contacts, m_Material);
+		m_Constraints.Prepare(m_Bodies, GetSolverMode());
+	}
+
+	void DoorSimulation::OnSolveConstraints(const float substepTime)
+	{
+		for (int i = 0; i < GetNumPosIterations(); ++i)
+		{
+			m_Constraints.Solve(m_Bodies, i, substepTime, GetSolverMode(), GetRelaxation());
+		}
+		m_ConstraintSolves += m_Constraints.Size() * GetNumPosIterations();
+	}
+
+	void DoorSimulation::OnSolveVelocities(const float substepTime)
+	{
+		m_Bodies.ApplyDamping(substepTime);
+
+		// Approach speeds gained from gravity within a couple of substeps do not bounce.
+		const float restitutionThreshold = 2.0f * std::abs(m_Gravity) * substepTime;
+		m_Constraints.SolveVelocities(m_Bodies, substepTime, restitutionThreshold);
+	}
+
+	void DoorSimulation::OnEndSimulationFrame()
+	{
+		m_Bodies.ClearForces();
+	}
+}
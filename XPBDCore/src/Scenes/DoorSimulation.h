@@ -0,0 +1,39 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+#include "Collision/ContactManifold.h"
+#include "Collision/SweepAndPrune.h"
+#include "Constraints/ConstraintRegistry.h"
+
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* A door on a limited, damped hinge, pulled towards a static stop by a soft distance constraint.
+	*/
+	class DoorSimulation : public SceneSimulation
+	{
+	public:
+		DoorSimulation();
+
+	protected:
+		void OnStartSimulationFrame() override;
+
+		void OnDetectCollisions(const float substepTime) override;
+
+		void OnSolveConstraints(const float substepTime) override;
+
+		void OnSolveVelocities(const float substepTime) override;
+
+		void OnEndSimulationFrame() override;
+
+	protected:
+		// The hinge, the door stop and the contacts live in different pools of the registry
+		ConstraintRegistry m_Constraints;
+		ContactMaterial m_Material;
+
+		SweepAndPrune m_Broadphase;
+
+		float m_Gravity = -10.0f;
+	};
+}
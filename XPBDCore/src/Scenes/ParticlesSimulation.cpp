@@ -0,0 +1,136 @@
+#include "ParticlesSimulation.h"
+#include "Simulation/JobSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
+namespace Simulation
+{
+	ParticlesSimulation::ParticlesSimulation()
+	{
+		AddEntity(BodyDesc{}, Eigen::Vector3f(-4.0f, 3.0f, 0.0f));
+		AddEntity(BodyDesc{}, Eigen::Vector3f(-3.0f, 5.0f, -1.0f));
+		AddEntity(BodyDesc{}, Eigen::Vector3f(-2.0f, 4.0f, 1.0f));
+
+		AddEntity(BodyDesc{}, Eigen::Vector3f(2.0f, 5.0f, 0.0f));
+		AddEntity(BodyDesc{}, Eigen::Vector3f(2.0f, 3.0f, 0.0f));
+
+		const std::array<std::pair<size_t, size_t>, 3> links = { { { 0, 1 }, { 1, 2 }, { 3, 4 } } };
+		for (size_t i = 0; i < links.size(); ++i)
+		{
+			const Entity& entity1 = m_Entities[links[i].first];
+			const Entity& entity2 = m_Entities[links[i].second];
+
+			PositionalConstraint constraint;
+			constraint.Body1 = entity1.Body;
+			constraint.Body2 = entity2.Body;
+			constraint.TargetDistance = entity1.ResetPosition - entity2.ResetPosition;
+			m_Constraints.Add(constraint);
+		}
+
+		Reset();
+	}
+
+	void ParticlesSimulation::OnStartSimulationFrame()
+	{
+		if (m_EnableGravity)
+		{
+			AddGravity(m_Gravity);
+		}
+
+		// Static flags and the solver mode can change from the editor, so the Jacobi incidence is rebuilt every frame.
+		m_Constraints.Prepare(m_Bodies, GetSolverMode());
+	}
+
+	void ParticlesSimulation::OnUpdatePosition(const float substepTime)
+	{
+		BodyStore& bodies = m_Bodies;
+		ParallelFor(0, (uint32_t)bodies.Size(), [&](const BodyHandle body)
+		{
+			bodies.PrevPositions[body] = bodies.Positions[body];
+
+			if (bodies.IsStatic(body))
+			{
+				return;
+			}
+
+			const Eigen::Vector3f totalForce = bodies.GetTotalForce(body);
+			bodies.LinearVelocities[body] += (bodies.InverseMasses[body] * substepTime) * totalForce;
+			bodies.Positions[body] += substepTime * bodies.LinearVelocities[body];
+		});
+	}
+
+	void ParticlesSimulation::OnDetectCollisions(const float)
+	{
+		m_ParticleContacts.clear();
+		if (!m_ParticleCollisions)
+		{
+			return;
+		}
+
+		const float contactDistance = 2.0f * m_ParticleRadius;
+		m_ParticleGrid.SetCellSize(contactDistance);
+		m_ParticleGrid.Build(m_Bodies.Positions);
+
+		for (BodyHandle body = 0; body < m_Bodies.Size(); ++body)
+		{
+			m_ParticleGrid.QueryRadius(m_Bodies.Positions[body], contactDistance, [&](const uint32_t other)
+			{
+				if (body < other && !(m_Bodies.IsStatic(body) && m_Bodies.IsStatic(other)))
+				{
+					m_ParticleContacts.push_back({ body, other });
+				}
+			});
+		}
+	}
+
+	void ParticlesSimulation::OnSolveConstraints(const float substepTime)
+	{
+		for (int i = 0; i < GetNumPosIterations(); ++i)
+		{
+			m_Constraints.Solve(m_Bodies, i, substepTime, GetSolverMode(), GetRelaxation());
+		}
+		m_ConstraintSolves += m_Constraints.Size() * GetNumPosIterations();
+
+		// Push overlapping particles apart, weighted by inverse mass
+		const float contactDistance = 2.0f * m_ParticleRadius;
+		for (const BodyPair& contact : m_ParticleContacts)
+		{
+			const float w1 = m_Bodies.IsStatic(contact.Body1) ? 0.0f : m_Bodies.InverseMasses[contact.Body1];
+			const float w2 = m_Bodies.IsStatic(contact.Body2) ? 0.0f : m_Bodies.InverseMasses[contact.Body2];
+			const Eigen::Vector3f delta = m_Bodies.Positions[contact.Body1] - m_Bodies.Positions[contact.Body2];
+			const float distance = delta.norm();
+			if (w1 + w2 <= 0.0f || distance >= contactDistance || distance <= FLT_EPSILON)
+			{
+				continue;
+			}
+
+			const Eigen::Vector3f correction = ((contactDistance - distance) / ((w1 + w2) * distance)) * delta;
+			m_Bodies.Positions[contact.Body1] += w1 * correction;
+			m_Bodies.Positions[contact.Body2] -= w2 * correction;
+		}
+
+		if (m_GroundCollisions)
+		{
+			for (Eigen::Vector3f& position : m_Bodies.Positions)
+			{
+				position.y() = std::max(position.y(), 0.0f);
+			}
+		}
+	}
+
+	void ParticlesSimulation::OnPostSolveConstraints(const float substepTime)
+	{
+		BodyStore& bodies = m_Bodies;
+		ParallelFor(0, (uint32_t)bodies.Size(), [&](const BodyHandle body)
+		{
+			bodies.LinearVelocities[body] = (bodies.Positions[body] - bodies.PrevPositions[body]) / substepTime;
+		});
+	}
+
+	void ParticlesSimulation::OnEndSimulationFrame()
+	{
+		m_Bodies.ClearForces();
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Scenes/SceneSimulation.h"
+#include "Collision/Aabb.h"
+#include "Collision/SpatialHashGrid.h"
+#include "Constraints/ConstraintRegistry.h"
+
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* Two chains of point masses on distance constraints, clamped above the ground.
+	*/
+	class ParticlesSimulation : public SceneSimulation
+	{
+	public:
+		ParticlesSimulation();
+
+	protected:
+		void OnStartSimulationFrame() override;
+
+		void OnUpdatePosition(const float substepTime) override;
+
+		void OnDetectCollisions(const float substepTime) override;
+
+		void OnSolveConstraints(const float substepTime) override;
+
+		void OnPostSolveConstraints(const float substepTime) override;
+
+		void OnEndSimulationFrame() override;
+
+	protected:
+		// Only the distance constraints of the chains, the particle contacts are pushed apart directly
+		ConstraintRegistry m_Constraints;
+
+		SpatialHashGrid m_ParticleGrid;
+		std::vector<BodyPair> m_ParticleContacts;
+
+		// Particles closer than twice this push each other apart
+		float m_ParticleRadius = 0.1f;
+		float m_Gravity = -9.8f;
+		bool m_EnableGravity = true;
+		bool m_GroundCollisions = true;
+		bool m_ParticleCollisions = false;
+	};
+}
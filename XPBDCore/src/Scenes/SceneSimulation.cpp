@@ -0,0 +1,76 @@
+#include "SceneSimulation.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	void SceneSimulation::Reset()
+	{
+		for (const Entity& entity : m_Entities)
+		{
+			entity.Reset(m_Bodies);
+		}
+		m_Contacts.clear();
+		m_GjkCaches.Clear();
+	}
+
+	uint64_t SceneSimulation::GetConstraintSolves() const
+	{
+		return m_ConstraintSolves;
+	}
+
+	BodyHandle SceneSimulation::AddEntity(const BodyDesc& desc, const Eigen::Vector3f& resetPosition, const Eigen::Vector3f& resetScale)
+	{
+		Entity& entity = m_Entities.emplace_back();
+		entity.Body = m_Bodies.Add(desc);
+		entity.ResetPosition = resetPosition;
+		entity.ResetScale = resetScale;
+		return entity.Body;
+	}
+
+	void SceneSimulation::AddGravity(const float gravity)
+	{
+		for (const Entity& entity : m_Entities)
+		{
+			m_Bodies.AddForce(entity.Body,
+				PhysicalForce{
+					Eigen::Vector3f::Zero(),
+					Eigen::Vector3f(0.0f, gravity / m_Bodies.InverseMasses[entity.Body], 0.0f),
+					false });
+		}
+	}
+
+	void SceneSimulation::IgnoreCollisions(BodyHandle body1, BodyHandle body2)
+	{
+		m_IgnoredPairs.push_back({ std::min(body1, body2), std::max(body1, body2) });
+	}
+
+	const std::vector<BodyPair>& SceneSimulation::FilterPairs(const std::vector<BodyPair>& pairs)
+	{
+		m_CollisionPairs.clear();
+		for (const BodyPair& pair : pairs)
+		{
+			const bool isIgnored = std::any_of(m_IgnoredPairs.begin(), m_IgnoredPairs.end(), [&pair](const BodyPair& ignored)
+			{
+				return ignored.Body1 == pair.Body1 && ignored.Body2 == pair.Body2;
+			});
+
+			if (!isIgnored)
+			{
+				m_CollisionPairs.push_back(pair);
+			}
+		}
+		return m_CollisionPairs;
+	}
+
+	Eigen::DiagonalMatrix<float, 3> SceneSimulation::ComputeInertiaTensorForCube(float W, float H, float L)
+	{
+		const float volume_12 = W * H * L / 12.0f;
+		const float Ixx = H * H + L * L;
+		const float Iyy = W * W + L * L;
+		const float Izz = W * W + H * H;
+
+		Eigen::DiagonalMatrix<float, 3> mat(Ixx, Iyy, Izz);
+		return volume_12 * mat;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "Collision/Aabb.h"
+#include "Collision/Narrowphase.h"
+#include "Simulation/Entity.h"
+#include "Simulation/PhysicsScene.h"
+
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* Bodies, constraints and forces of one of the sandbox scenes, without drawing, editor or keyboard input.
+	* The Engine scenes draw on top of these and the benchmarks step them without a window.
+	* PhysicsScene is a virtual base, so an Engine scene can derive from both this and Engine::Scene.
+	*/
+	class SceneSimulation : public virtual PhysicsScene
+	{
+	public:
+		/**
+		* Puts every body back to its reset transform and velocity.
+		*/
+		void Reset();
+
+		// Constraints solved since the scene was created, each constraint counted once per position iteration
+		uint64_t GetConstraintSolves() const;
+
+	protected:
+		// Adds a body together with the transform it resets to
+		BodyHandle AddEntity(const BodyDesc& desc, const Eigen::Vector3f& resetPosition, const Eigen::Vector3f& resetScale = Eigen::Vector3f::Ones());
+
+		// Same acceleration for every body, whatever its mass
+		void AddGravity(const float gravity);
+
+		// Hinged bodies overlap around the hinge, so the scenes keep them from colliding.
+		void IgnoreCollisions(BodyHandle body1, BodyHandle body2);
+
+		/**
+		* Copies the broadphase pairs without the ignored ones, the result stays valid until the next call.
+		*/
+		const std::vector<BodyPair>& FilterPairs(const std::vector<BodyPair>& pairs);
+
+		static Eigen::DiagonalMatrix<float, 3> ComputeInertiaTensorForCube(float W, float H, float L);
+
+	protected:
+		std::vector<Entity> m_Entities;
+		uint64_t m_ConstraintSolves = 0;
+		// Warm starts GJK on the pairs the broadphase keeps from one substep to the next
+		GjkPairCaches m_GjkCaches;
+
+	private:
+		// Body1 < Body2, like the broadphase pairs
+		std::vector<BodyPair> m_IgnoredPairs;
+		std::vector<BodyPair> m_CollisionPairs;
+	};
+}
@@ -0,0 +1,247 @@
+#include "BodyIntegrator.h"
+
+#include "Constraints/ConstraintKernels.h"
+#include "Simulation/JobSystem.h"
+#include "Simulation/Simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Simulation
+{
+	template<typename T>
+	struct BodyMotion
+	{
+		Simd::Vector3T<T> Position;
+		Simd::QuaternionT<T> Rotation;
+		Simd::Vector3T<T> LinearVelocity;
+		Simd::Vector3T<T> AngularVelocity;
+	};
+
+	template<typename T>
+	static BodyMotion<T> Integrate(const BodyMotion<T>& motion, const Simd::Vector3T<T>& force, const Simd::Vector3T<T>& torque,
+		const T inverseMass, const Simd::Matrix3T<T>& inertia, const Simd::Matrix3T<T>& inverseInertia, const T substepTime)
+	{
+		BodyMotion<T> result;
+		result.LinearVelocity = motion.LinearVelocity + (substepTime * inverseMass) * force;
+		result.Position = motion.Position + substepTime * result.LinearVelocity;
+
+		const Simd::Vector3T<T>& angularVelocity = motion.AngularVelocity;
+		result.AngularVelocity = angularVelocity + substepTime * (inverseInertia * (torque - Simd::Cross(angularVelocity, inertia * angularVelocity)));
+		// q += 0.5 * dt * [w, 0] * q, normalized
+		result.Rotation = Simd::ApplyRotationCorrection(motion.Rotation, substepTime * result.AngularVelocity);
+		return result;
+	}
+
+	template<typename T>
+	static void DeriveVelocity(const BodyMotion<T>& motion, const Simd::Vector3T<T>& prevPosition, const Simd::QuaternionT<T>& prevRotation,
+		const T inverseSubstepTime, Simd::Vector3T<T>& linearVelocity, Simd::Vector3T<T>& angularVelocity)
+	{
+		linearVelocity = inverseSubstepTime * (motion.Position - prevPosition);
+
+		// Vector part of q * prev^-1, the conjugate standing in for the inverse of the unit quaternion
+		const Simd::QuaternionT<T>& q = motion.Rotation;
+		const Simd::QuaternionT<T>& p = prevRotation;
+		const Simd::Vector3T<T> deltaQ{
+			p.W * q.X - q.W * p.X - q.Y * p.Z + q.Z * p.Y,
+			p.W * q.Y - q.W * p.Y - q.Z * p.X + q.X * p.Z,
+			p.W * q.Z - q.W * p.Z - q.X * p.Y + q.Y * p.X };
+		const T deltaW = q.W * p.W + q.X * p.X + q.Y * p.Y + q.Z * p.Z;
+
+		// Take the shorter of the two arcs the quaternion pair describes
+		const T twoOverDt = T(2.0f) * inverseSubstepTime;
+		angularVelocity = Simd::Select(deltaW > T(0.0f), twoOverDt, -twoOverDt) * deltaQ;
+	}
+
+	/**
+	* All ones in the lanes of simulated bodies, built without branching on the flags.
+	*/
+	static Simd::FloatLanes LoadSimulatedMask(const BodyStore& bodies, const uint32_t first)
+	{
+		alignas(32) float mask[Simd::LANE_WIDTH];
+		for (uint32_t lane = 0; lane < Simd::LANE_WIDTH; ++lane)
+		{
+			const uint32_t bits = 0u - (uint32_t)bodies.IsSimulated(first + lane);
+			std::memcpy(&mask[lane], &bits, sizeof(float));
+		}
+		return Simd::Load(mask);
+	}
+
+	static void GatherMotion(const BodyStore& bodies, const uint32_t* indices, BodyMotion<Simd::FloatLanes>& motion)
+	{
+		using Simd::Gather;
+
+		// Eigen stores Vector3f as 3 floats and Quaternionf as x, y, z, w.
+		const float* positions = bodies.Positions[0].data();
+		const float* rotations = bodies.Rotations[0].coeffs().data();
+		const float* linearVelocities = bodies.LinearVelocities[0].data();
+		const float* angularVelocities = bodies.AngularVelocities[0].data();
+
+		motion.Position = { Gather(positions, indices, 3, 0), Gather(positions, indices, 3, 1), Gather(positions, indices, 3, 2) };
+		motion.Rotation = { Gather(rotations, indices, 4, 0), Gather(rotations, indices, 4, 1), Gather(rotations, indices, 4, 2), Gather(rotations, indices, 4, 3) };
+		motion.LinearVelocity = { Gather(linearVelocities, indices, 3, 0), Gather(linearVelocities, indices, 3, 1), Gather(linearVelocities, indices, 3, 2) };
+		motion.AngularVelocity = { Gather(angularVelocities, indices, 3, 0), Gather(angularVelocities, indices, 3, 1), Gather(angularVelocities, indices, 3, 2) };
+	}
+
+	static Simd::Matrix3Lanes GatherMatrix(const std::vector<Eigen::Matrix3f>& matrices, const uint32_t* indices)
+	{
+		// Eigen matrices are column-major, the kernels use row-major
+		Simd::Matrix3Lanes matrix;
+		for (uint32_t i = 0; i < 9; ++i)
+		{
+			matrix.M[i] = Simd::Gather(matrices[0].data(), indices, 9, (i % 3) * 3 + i / 3);
+		}
+		return matrix;
+	}
+
+	static void IntegratePack(BodyStore& bodies, const uint32_t first, const float substepTime)
+	{
+		using namespace Simd;
+
+		std::copy_n(bodies.Positions.begin() + first, LANE_WIDTH, bodies.PrevPositions.begin() + first);
+		std::copy_n(bodies.Rotations.begin() + first, LANE_WIDTH, bodies.PrevRotations.begin() + first);
+
+		const FloatLanes simulated = LoadSimulatedMask(bodies, first);
+		if (!AnyTrue(simulated))
+		{
+			return;
+		}
+
+		alignas(32) uint32_t indices[LANE_WIDTH];
+		for (uint32_t lane = 0; lane < LANE_WIDTH; ++lane)
+		{
+			indices[lane] = first + lane;
+		}
+
+		BodyMotion<FloatLanes> motion;
+		GatherMotion(bodies, indices, motion);
+
+		const float* forces = bodies.NetForces[0].data();
+		const float* torques = bodies.NetTorques[0].data();
+		const Vector3Lanes force{ Gather(forces, indices, 3, 0), Gather(forces, indices, 3, 1), Gather(forces, indices, 3, 2) };
+		const Vector3Lanes torque{ Gather(torques, indices, 3, 0), Gather(torques, indices, 3, 1), Gather(torques, indices, 3, 2) };
+		const FloatLanes inverseMass = Load(&bodies.InverseMasses[first]);
+
+		const BodyMotion<FloatLanes> integrated = Integrate(motion, force, torque, inverseMass,
+			GatherMatrix(bodies.InertiaTensors, indices), GatherMatrix(bodies.InverseInertiaTensors, indices), Set1(substepTime));
+
+		// Masked lanes write their own state back unchanged
+		const Vector3Lanes position = Select(simulated, integrated.Position, motion.Position);
+		const QuaternionLanes rotation = Select(simulated, integrated.Rotation, motion.Rotation);
+		const Vector3Lanes linearVelocity = Select(simulated, integrated.LinearVelocity, motion.LinearVelocity);
+		const Vector3Lanes angularVelocity = Select(simulated, integrated.AngularVelocity, motion.AngularVelocity);
+
+		float* positions = bodies.Positions[0].data();
+		float* rotations = bodies.Rotations[0].coeffs().data();
+		float* linearVelocities = bodies.LinearVelocities[0].data();
+		float* angularVelocities = bodies.AngularVelocities[0].data();
+		Scatter(positions, indices, 3, 0, position.X); Scatter(positions, indices, 3, 1, position.Y); Scatter(positions, indices, 3, 2, position.Z);
+		Scatter(rotations, indices, 4, 0, rotation.X); Scatter(rotations, indices, 4, 1, rotation.Y); Scatter(rotations, indices, 4, 2, rotation.Z); Scatter(rotations, indices, 4, 3, rotation.W);
+		Scatter(linearVelocities, indices, 3, 0, linearVelocity.X); Scatter(linearVelocities, indices, 3, 1, linearVelocity.Y); Scatter(linearVelocities, indices, 3, 2, linearVelocity.Z);
+		Scatter(angularVelocities, indices, 3, 0, angularVelocity.X); Scatter(angularVelocities, indices, 3, 1, angularVelocity.Y); Scatter(angularVelocities, indices, 3, 2, angularVelocity.Z);
+	}
+
+	static void DerivePack(BodyStore& bodies, const uint32_t first, const float substepTime)
+	{
+		using namespace Simd;
+
+		const FloatLanes simulated = LoadSimulatedMask(bodies, first);
+		if (!AnyTrue(simulated))
+		{
+			return;
+		}
+
+		alignas(32) uint32_t indices[LANE_WIDTH];
+		for (uint32_t lane = 0; lane < LANE_WIDTH; ++lane)
+		{
+			indices[lane] = first + lane;
+		}
+
+		BodyMotion<FloatLanes> motion;
+		GatherMotion(bodies, indices, motion);
+
+		const float* prevPositions = bodies.PrevPositions[0].data();
+		const float* prevRotations = bodies.PrevRotations[0].coeffs().data();
+		const Vector3Lanes prevPosition{ Gather(prevPositions, indices, 3, 0), Gather(prevPositions, indices, 3, 1), Gather(prevPositions, indices, 3, 2) };
+		const QuaternionLanes prevRotation{ Gather(prevRotations, indices, 4, 0), Gather(prevRotations, indices, 4, 1), Gather(prevRotations, indices, 4, 2), Gather(prevRotations, indices, 4, 3) };
+
+		Vector3Lanes linearVelocity;
+		Vector3Lanes angularVelocity;
+		DeriveVelocity(motion, prevPosition, prevRotation, Set1(1.0f / substepTime), linearVelocity, angularVelocity);
+		linearVelocity = Select(simulated, linearVelocity, motion.LinearVelocity);
+		angularVelocity = Select(simulated, angularVelocity, motion.AngularVelocity);
+
+		float* linearVelocities = bodies.LinearVelocities[0].data();
+		float* angularVelocities = bodies.AngularVelocities[0].data();
+		Scatter(linearVelocities, indices, 3, 0, linearVelocity.X); Scatter(linearVelocities, indices, 3, 1, linearVelocity.Y); Scatter(linearVelocities, indices, 3, 2, linearVelocity.Z);
+		Scatter(angularVelocities, indices, 3, 0, angularVelocity.X); Scatter(angularVelocities, indices, 3, 1, angularVelocity.Y); Scatter(angularVelocities, indices, 3, 2, angularVelocity.Z);
+	}
+
+	static BodyMotion<float> GetMotion(const BodyStore& bodies, const BodyHandle body)
+	{
+		return { ToKernel(bodies.Positions[body]), ToKernel(bodies.Rotations[body]), ToKernel(bodies.LinearVelocities[body]), ToKernel(bodies.AngularVelocities[body]) };
+	}
+
+	// The bodies past the last whole pack run through the same kernels one at a time.
+	static void IntegrateBody(BodyStore& bodies, const BodyHandle body, const float substepTime)
+	{
+		bodies.PrevPositions[body] = bodies.Positions[body];
+		bodies.PrevRotations[body] = bodies.Rotations[body];
+		if (!bodies.IsSimulated(body))
+		{
+			return;
+		}
+
+		const BodyMotion<float> integrated = Integrate(GetMotion(bodies, body), ToKernel(bodies.NetForces[body]), ToKernel(bodies.NetTorques[body]),
+			bodies.InverseMasses[body], ToKernel(bodies.InertiaTensors[body]), ToKernel(bodies.InverseInertiaTensors[body]), substepTime);
+
+		bodies.Positions[body] = FromKernel(integrated.Position);
+		bodies.Rotations[body] = FromKernel(integrated.Rotation);
+		bodies.LinearVelocities[body] = FromKernel(integrated.LinearVelocity);
+		bodies.AngularVelocities[body] = FromKernel(integrated.AngularVelocity);
+	}
+
+	static void DeriveBodyVelocity(BodyStore& bodies, const BodyHandle body, const float substepTime)
+	{
+		if (!bodies.IsSimulated(body))
+		{
+			return;
+		}
+
+		Simd::Vector3T<float> linearVelocity;
+		Simd::Vector3T<float> angularVelocity;
+		DeriveVelocity(GetMotion(bodies, body), ToKernel(bodies.PrevPositions[body]), ToKernel(bodies.PrevRotations[body]), 1.0f / substepTime, linearVelocity, angularVelocity);
+		bodies.LinearVelocities[body] = FromKernel(linearVelocity);
+		bodies.AngularVelocities[body] = FromKernel(angularVelocity);
+	}
+
+	void IntegrateBodies(BodyStore& bodies, const float substepTime)
+	{
+		const uint32_t numBodies = (uint32_t)bodies.Size();
+		const uint32_t numPacks = numBodies / Simd::LANE_WIDTH;
+		ParallelFor(0, numPacks, [&bodies, substepTime](const uint32_t pack)
+		{
+			IntegratePack(bodies, pack * Simd::LANE_WIDTH, substepTime);
+		}, 32);
+
+		for (BodyHandle body = numPacks * Simd::LANE_WIDTH; body < numBodies; ++body)
+		{
+			IntegrateBody(bodies, body, substepTime);
+		}
+	}
+
+	void DeriveVelocities(BodyStore& bodies, const float substepTime)
+	{
+		const uint32_t numBodies = (uint32_t)bodies.Size();
+		const uint32_t numPacks = numBodies / Simd::LANE_WIDTH;
+		ParallelFor(0, numPacks, [&bodies, substepTime](const uint32_t pack)
+		{
+			DerivePack(bodies, pack * Simd::LANE_WIDTH, substepTime);
+		}, 32);
+
+		for (BodyHandle body = numPacks * Simd::LANE_WIDTH; body < numBodies; ++body)
+		{
+			DeriveBodyVelocity(bodies, body, substepTime);
+		}
+	}
+}
\ No newline at end of file
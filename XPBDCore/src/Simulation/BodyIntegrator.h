@@ -0,0 +1,19 @@
+#pragma once
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Semi-implicit Euler step of every body, Simd::LANE_WIDTH consecutive bodies at a time:
+	* stores the previous transform, applies the net force and torque with the gyroscopic term,
+	* then moves the positions and rotations. Static and sleeping bodies are masked out per lane.
+	* Runs in parallel, call UpdateTransformCache afterwards.
+	*/
+	void IntegrateBodies(BodyStore& bodies, const float substepTime);
+
+	/**
+	* Recomputes the linear and angular velocities of every simulated body from the change of its
+	* position and rotation since IntegrateBodies, batched the same way.
+	*/
+	void DeriveVelocities(BodyStore& bodies, const float substepTime);
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "BodyStore.h"
+#include "Simulation/JobSystem.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	BodyHandle BodyStore::Add(const BodyDesc& desc)
+	{
+		const BodyHandle handle = static_cast<BodyHandle>(Positions.size());
+
+		Positions.push_back(Eigen::Vector3f::Zero());
+		Rotations.push_back(Eigen::Quaternionf::Identity());
+		Scales.push_back(Eigen::Vector3f::Ones());
+
+		PrevPositions.push_back(Eigen::Vector3f::Zero());
+		PrevRotations.push_back(Eigen::Quaternionf::Identity());
+
+		LinearVelocities.push_back(Eigen::Vector3f::Zero());
+		AngularVelocities.push_back(Eigen::Vector3f::Zero());
+
+		LinearDampings.push_back(desc.LinearDamping);
+		AngularDampings.push_back(desc.AngularDamping);
+
+		InverseMasses.push_back(desc.InverseMass);
+		InertiaTensors.push_back(desc.InertiaTensor);
+		InverseInertiaTensors.push_back(desc.InertiaTensor.inverse());
+
+		uint8_t flags = BODY_FLAG_ACTIVE;
+		flags |= desc.IsStaticBody ? BODY_FLAG_STATIC : BODY_FLAG_NONE;
+		flags |= desc.IsStaticForCorrection ? BODY_FLAG_STATIC_FOR_CORRECTION : BODY_FLAG_NONE;
+		Flags.push_back(flags);
+		Colliders.push_back(desc.BodyCollider);
+
+		RotationMatrices.push_back(Eigen::Matrix3f::Identity());
+		WorldInverseInertiaTensors.push_back(InverseInertiaTensors.back());
+		TransformCacheDirty.push_back(1);
+
+		NetForces.push_back(Eigen::Vector3f::Zero());
+		NetTorques.push_back(Eigen::Vector3f::Zero());
+		ForceHistory.emplace_back();
+
+		++StaticVersion;
+		return handle;
+	}
+
+	void BodyStore::Clear()
+	{
+		Positions.clear();
+		Rotations.clear();
+		Scales.clear();
+
+		PrevPositions.clear();
+		PrevRotations.clear();
+
+		LinearVelocities.clear();
+		AngularVelocities.clear();
+
+		LinearDampings.clear();
+		AngularDampings.clear();
+
+		InverseMasses.clear();
+		InertiaTensors.clear();
+		InverseInertiaTensors.clear();
+
+		Flags.clear();
+		Colliders.clear();
+
+		RotationMatrices.clear();
+		WorldInverseInertiaTensors.clear();
+		TransformCacheDirty.clear();
+
+		NetForces.clear();
+		NetTorques.clear();
+		ForceHistory.clear();
+
+		++StaticVersion;
+	}
+
+	size_t BodyStore::Size() const
+	{
+		return Positions.size();
+	}
+
+	bool BodyStore::HasFlag(BodyHandle body, BodyFlags flag) const
+	{
+		return (Flags[body] & flag) != 0;
+	}
+
+	void BodyStore::SetFlag(BodyHandle body, BodyFlags flag, bool value)
+	{
+		if ((flag & BODY_FLAG_STATIC) && IsStatic(body) != value)
+		{
+			++StaticVersion;
+		}
+
+		if (value)
+		{
+			Flags[body] |= flag;
+		}
+		else
+		{
+			Flags[body] &= ~flag;
+		}
+	}
+
+	bool BodyStore::IsStatic(BodyHandle body) const
+	{
+		return HasFlag(body, BODY_FLAG_STATIC);
+	}
+
+	bool BodyStore::CanCorrectRotation(BodyHandle body) const
+	{
+		return (Flags[body] & (BODY_FLAG_STATIC | BODY_FLAG_STATIC_FOR_CORRECTION)) == 0;
+	}
+
+	bool BodyStore::IsSimulated(BodyHandle body) const
+	{
+		return (Flags[body] & (BODY_FLAG_STATIC | BODY_FLAG_ACTIVE)) == BODY_FLAG_ACTIVE;
+	}
+
+	void BodyStore::WakeUp(BodyHandle body)
+	{
+		SetFlag(body, BODY_FLAG_ACTIVE, true);
+	}
+
+	void BodyStore::UpdateTransformCache()
+	{
+		ParallelFor(0, (uint32_t)Size(), [this](const BodyHandle body)
+		{
+			UpdateTransformCache(body);
+		});
+	}
+
+	void BodyStore::UpdateTransformCache(BodyHandle body)
+	{
+		const Eigen::Matrix3f rotationMat = Rotations[body].toRotationMatrix();
+		RotationMatrices[body] = rotationMat;
+		WorldInverseInertiaTensors[body] = rotationMat * InverseInertiaTensors[body] * rotationMat.transpose();
+		TransformCacheDirty[body] = 0;
+	}
+
+	void BodyStore::InvalidateTransformCache(BodyHandle body)
+	{
+		TransformCacheDirty[body] = 1;
+	}
+
+	const Eigen::Matrix3f& BodyStore::GetRotationMatrix(BodyHandle body)
+	{
+		if (TransformCacheDirty[body])
+		{
+			UpdateTransformCache(body);
+		}
+		return RotationMatrices[body];
+	}
+
+	const Eigen::Matrix3f& BodyStore::GetWorldInverseInertia(BodyHandle body)
+	{
+		if (TransformCacheDirty[body])
+		{
+			UpdateTransformCache(body);
+		}
+		return WorldInverseInertiaTensors[body];
+	}
+
+	void BodyStore::ApplyDamping(const float substepTime)
+	{
+		ParallelFor(0, (uint32_t)Size(), [this, substepTime](const BodyHandle body)
+		{
+			if (!IsSimulated(body))
+			{
+				return;
+			}
+
+			LinearVelocities[body] *= std::max(1.0f - LinearDampings[body] * substepTime, 0.0f);
+			AngularVelocities[body] *= std::max(1.0f - AngularDampings[body] * substepTime, 0.0f);
+		});
+	}
+
+	void BodyStore::AddForce(BodyHandle body, PhysicalForce force)
+	{
+		if (force.IsLocal)
+		{
+			// Not considering the translation as we want the force to be centered at the body
+			const Eigen::Matrix3f& rotationMat = GetRotationMatrix(body);
+			force.Vector = rotationMat * force.Vector;
+			force.Position = rotationMat * Scales[body].cwiseProduct(force.Position);
+			force.IsLocal = false;
+		}
+
+		NetForces[body] += force.Vector;
+		// All bodies are assumed to have origin as center of mass.
+		NetTorques[body] += force.Position.cross(force.Vector);
+
+		if (HasFlag(body, BODY_FLAG_RECORD_FORCES))
+		{
+			ForceHistory[body].push_back(force);
+		}
+	}
+
+	const Eigen::Vector3f& BodyStore::GetTotalForce(BodyHandle body) const
+	{
+		return NetForces[body];
+	}
+
+	const Eigen::Vector3f& BodyStore::GetTotalTorque(BodyHandle body) const
+	{
+		return NetTorques[body];
+	}
+
+	void BodyStore::ClearForces()
+	{
+		std::fill(NetForces.begin(), NetForces.end(), Eigen::Vector3f::Zero());
+		std::fill(NetTorques.begin(), NetTorques.end(), Eigen::Vector3f::Zero());
+
+		for (auto& forces : ForceHistory)
+		{
+			forces.clear();
+		}
+	}
+}
\ No newline at end of file
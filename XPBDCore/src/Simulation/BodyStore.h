@@ -0,0 +1,138 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "Collision/Collider.h"
+
+namespace Simulation
+{
+	using BodyHandle = uint32_t;
+	constexpr BodyHandle INVALID_BODY_HANDLE = UINT32_MAX;
+
+	enum BodyFlags : uint8_t
+	{
+		BODY_FLAG_NONE = 0,
+		BODY_FLAG_STATIC = 1 << 0,
+		BODY_FLAG_STATIC_FOR_CORRECTION = 1 << 1,
+		BODY_FLAG_ACTIVE = 1 << 2,
+		// Keep every force added this frame in ForceHistory, for debug drawing
+		BODY_FLAG_RECORD_FORCES = 1 << 3,
+	};
+
+	struct PhysicalForce
+	{
+		Eigen::Vector3f Position = Eigen::Vector3f::Zero();
+		Eigen::Vector3f Vector = Eigen::Vector3f::Zero();
+		bool IsLocal = false;
+	};
+
+	struct BodyDesc
+	{
+		float InverseMass = 1.0f;
+		Eigen::Matrix3f InertiaTensor = Eigen::Matrix3f::Identity();
+
+		bool IsStaticBody = false;
+		bool IsStaticForCorrection = false;
+
+		// Fraction of the linear and angular velocity removed per second, see BodyStore::ApplyDamping
+		float LinearDamping = 0.0f;
+		float AngularDamping = 0.0f;
+
+		Collider BodyCollider;
+	};
+
+	/**
+	* Structure-of-arrays storage for every simulated body.
+	* The solver loops only touch the arrays they need, bodies are referenced by index.
+	*/
+	struct BodyStore
+	{
+		// Transform
+		std::vector<Eigen::Vector3f> Positions;
+		std::vector<Eigen::Quaternionf> Rotations;
+		std::vector<Eigen::Vector3f> Scales;
+
+		std::vector<Eigen::Vector3f> PrevPositions;
+		std::vector<Eigen::Quaternionf> PrevRotations;
+
+		// XPBD Data
+		std::vector<Eigen::Vector3f> LinearVelocities;
+		std::vector<Eigen::Vector3f> AngularVelocities;
+
+		std::vector<float> LinearDampings;
+		std::vector<float> AngularDampings;
+
+		std::vector<float> InverseMasses;
+		std::vector<Eigen::Matrix3f> InertiaTensors;
+		std::vector<Eigen::Matrix3f> InverseInertiaTensors;
+
+		std::vector<uint8_t> Flags;
+		std::vector<Collider> Colliders;
+
+		// Derived from Rotations: computed once per substep after integration by UpdateTransformCache,
+		// and recomputed lazily for a body after a solver rotated it.
+		std::vector<Eigen::Matrix3f> RotationMatrices;
+		std::vector<Eigen::Matrix3f> WorldInverseInertiaTensors;
+		std::vector<uint8_t> TransformCacheDirty;
+
+		// Net external force and torque for the current frame, accumulated by AddForce in world space
+		std::vector<Eigen::Vector3f> NetForces;
+		std::vector<Eigen::Vector3f> NetTorques;
+		// Individual forces of bodies flagged with BODY_FLAG_RECORD_FORCES, empty for every other body
+		std::vector<std::vector<PhysicalForce>> ForceHistory;
+
+		// Bumped whenever a body is added or removed, or a static flag changes.
+		// Data built from the set of dynamic bodies, like constraint colorings, compares against it to know when to rebuild.
+		uint32_t StaticVersion = 0;
+
+		BodyHandle Add(const BodyDesc& desc);
+		void Clear();
+		size_t Size() const;
+
+		bool HasFlag(BodyHandle body, BodyFlags flag) const;
+		void SetFlag(BodyHandle body, BodyFlags flag, bool value);
+
+		bool IsStatic(BodyHandle body) const;
+		bool CanCorrectRotation(BodyHandle body) const;
+		/**
+		* Dynamic and awake. Bodies of sleeping islands are left alone by the integrators and solvers.
+		*/
+		bool IsSimulated(BodyHandle body) const;
+		/**
+		* Wakes a sleeping body, the rest of its island follows at the next BodyIslands::UpdateSleeping.
+		* BodyIslands::WakeIsland wakes the whole island at once.
+		*/
+		void WakeUp(BodyHandle body);
+
+		/**
+		* Recomputes the rotation matrix and world inverse inertia of every body, in parallel.
+		*/
+		void UpdateTransformCache();
+		void UpdateTransformCache(BodyHandle body);
+		/**
+		* Must be called after writing Rotations[body] outside of the integration step.
+		*/
+		void InvalidateTransformCache(BodyHandle body);
+
+		const Eigen::Matrix3f& GetRotationMatrix(BodyHandle body);
+		const Eigen::Matrix3f& GetWorldInverseInertia(BodyHandle body);
+
+		/**
+		* Scales the velocities of every dynamic body by 1 - damping * substepTime, in parallel.
+		*/
+		void ApplyDamping(const float substepTime);
+
+		/**
+		* Adds the force to the net force and torque of the body.
+		* Local forces are transformed to world space first, using the cached rotation.
+		*/
+		void AddForce(BodyHandle body, PhysicalForce force);
+		const Eigen::Vector3f& GetTotalForce(BodyHandle body) const;
+		const Eigen::Vector3f& GetTotalTorque(BodyHandle body) const;
+		/**
+		* Resets the accumulators, does not free any memory.
+		*/
+		void ClearForces();
+	};
+}
@@ -0,0 +1,71 @@
+#include "ConstraintColoring.h"
+
+namespace Simulation
+{
+	namespace
+	{
+		constexpr uint32_t UNCOLORED = UINT32_MAX;
+
+		bool IsSharedBody(const BodyStore& bodies, const BodyHandle body)
+		{
+			return body != INVALID_BODY_HANDLE && !bodies.IsStatic(body);
+		}
+	}
+
+	void ConstraintColoring::Build(const BodyStore& bodies, const std::vector<ConstraintBodies>& constraintBodies)
+	{
+		const uint32_t numConstraints = (uint32_t)constraintBodies.size();
+
+		Order.clear();
+		Order.reserve(numConstraints);
+		ColorStarts.clear();
+		ColorStarts.push_back(0);
+
+		// Greedy coloring: every pass takes, in array order, each remaining constraint whose bodies
+		// were not claimed yet in this pass. The body stamp avoids clearing a per-body array each pass.
+		m_ConstraintColors.assign(numConstraints, UNCOLORED);
+		m_BodyStamps.assign(bodies.Size(), UNCOLORED);
+
+		uint32_t numColored = 0;
+		for (uint32_t color = 0; numColored < numConstraints; ++color)
+		{
+			for (uint32_t i = 0; i < numConstraints; ++i)
+			{
+				if (m_ConstraintColors[i] != UNCOLORED)
+				{
+					continue;
+				}
+
+				const BodyHandle body1 = constraintBodies[i].Body1;
+				const BodyHandle body2 = constraintBodies[i].Body2;
+				const bool shared1 = IsSharedBody(bodies, body1);
+				const bool shared2 = IsSharedBody(bodies, body2);
+
+				if ((shared1 && m_BodyStamps[body1] == color) || (shared2 && m_BodyStamps[body2] == color))
+				{
+					continue;
+				}
+
+				if (shared1)
+				{
+					m_BodyStamps[body1] = color;
+				}
+				if (shared2)
+				{
+					m_BodyStamps[body2] = color;
+				}
+
+				m_ConstraintColors[i] = color;
+				Order.push_back(i);
+				++numColored;
+			}
+
+			ColorStarts.push_back((uint32_t)Order.size());
+		}
+	}
+
+	size_t ConstraintColoring::GetNumColors() const
+	{
+		return ColorStarts.empty() ? 0 : ColorStarts.size() - 1;
+	}
+}
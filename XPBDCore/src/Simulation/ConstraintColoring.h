@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Simulation/BodyStore.h"
+#include "Simulation/JobSystem.h"
+
+namespace Simulation
+{
+	struct ConstraintBodies
+	{
+		BodyHandle Body1 = INVALID_BODY_HANDLE;
+		BodyHandle Body2 = INVALID_BODY_HANDLE;
+	};
+
+	/**
+	* Splits a constraint array into colors where no two constraints of a color share a dynamic body.
+	* Static bodies are never written by the solver, so they do not link constraints together.
+	* Colors are solved one after another, the constraints inside a color can be solved in parallel.
+	*/
+	struct ConstraintColoring
+	{
+		// Constraint indices grouped by color, each color keeps the original array order.
+		std::vector<uint32_t> Order;
+		// Offset of each color into Order, with one extra entry marking the end.
+		std::vector<uint32_t> ColorStarts;
+
+		void Build(const BodyStore& bodies, const std::vector<ConstraintBodies>& constraintBodies);
+
+		template<typename TContainer>
+		void Build(const BodyStore& bodies, const TContainer& constraints);
+
+		size_t GetNumColors() const;
+
+	private:
+		// Scratch kept between builds, so recoloring every substep does not allocate
+		std::vector<ConstraintBodies> m_Scratch;
+		std::vector<uint32_t> m_ConstraintColors;
+		std::vector<uint32_t> m_BodyStamps;
+	};
+
+	template<typename TContainer>
+	void ConstraintColoring::Build(const BodyStore& bodies, const TContainer& constraints)
+	{
+		m_Scratch.clear();
+		m_Scratch.reserve(constraints.size());
+		for (const auto& constraint : constraints)
+		{
+			m_Scratch.push_back({ constraint.Body1, constraint.Body2 });
+		}
+		Build(bodies, m_Scratch);
+	}
+
+	/**
+	* Calls solve(constraintIndex) for every constraint, color by color.
+	* Within a color the constraints touch disjoint bodies, so the result matches solving them serially.
+	*/
+	template<typename TFunc>
+	void SolveColored(const ConstraintColoring& coloring, TFunc&& solve)
+	{
+		for (size_t color = 0; color < coloring.GetNumColors(); ++color)
+		{
+			ParallelFor(coloring.ColorStarts[color], coloring.ColorStarts[color + 1],
+				[&coloring, &solve](const uint32_t i)
+				{
+					solve(coloring.Order[i]);
+				});
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Eigen/Dense"
+
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Cold per-body data (reset state).
+	* The simulated state lives in the BodyStore and is reached through the handle.
+	*/
+	struct Entity
+	{
+		BodyHandle Body;
+
+		// Reset Transform
+		Eigen::Vector3f ResetPosition;
+		Eigen::Quaternionf ResetRotation;
+		Eigen::Vector3f ResetScale;
+		Eigen::Vector3f ResetAngularVelocity;
+		Eigen::Vector3f ResetLinearVelocity;
+
+		Entity()
+			:
+			Body(INVALID_BODY_HANDLE),
+			ResetPosition(Eigen::Vector3f::Zero()),
+			ResetRotation(Eigen::Quaternionf::Identity()),
+			ResetScale(Eigen::Vector3f::Ones()),
+			ResetAngularVelocity(Eigen::Vector3f::Zero()),
+			ResetLinearVelocity(Eigen::Vector3f::Zero())
+		{
+		}
+
+		void Reset(BodyStore& bodies) const
+		{
+			bodies.Positions[Body] = ResetPosition;
+			bodies.Rotations[Body] = ResetRotation;
+			bodies.InvalidateTransformCache(Body);
+			bodies.Scales[Body] = ResetScale;
+
+			bodies.AngularVelocities[Body] = ResetAngularVelocity;
+			bodies.LinearVelocities[Body] = ResetLinearVelocity;
+			bodies.WakeUp(Body);
+		}
+	};
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <Eigen/Dense>
+
+namespace Simulation
+{
+	/**
+	* Plain three float vector for data stored in constraint pools.
+	* Unlike Eigen::Vector3f it is trivially copyable, so pools can be memcpy'd and packed tightly.
+	* Converts to and from Eigen::Vector3f where the solver math needs it.
+	*/
+	struct Float3
+	{
+		float X = 0.0f;
+		float Y = 0.0f;
+		float Z = 0.0f;
+
+		Float3() = default;
+		Float3(const float x, const float y, const float z) : X(x), Y(y), Z(z) {}
+		template<typename TDerived>
+		Float3(const Eigen::MatrixBase<TDerived>& v) : X(v.x()), Y(v.y()), Z(v.z()) {}
+
+		operator Eigen::Vector3f() const { return ToEigen(); }
+		Eigen::Vector3f ToEigen() const { return Eigen::Vector3f(X, Y, Z); }
+
+		float operator()(const int axis) const { return axis == 0 ? X : (axis == 1 ? Y : Z); }
+
+		// For editor widgets that take a float[3]
+		float* Data() { return &X; }
+	};
+
+	static_assert(std::is_trivially_copyable_v<Float3>);
+	static_assert(sizeof(Float3) == 3 * sizeof(float));
+}
@@ -0,0 +1,148 @@
+#include "FrameArena.h"
+#include "Simulation/JobSystem.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Simulation
+{
+	namespace
+	{
+		// Blocks are cache line aligned so allocations from different threads never share a line.
+		constexpr size_t BLOCK_ALIGNMENT = 64;
+	}
+
+	FrameArena::FrameArena(const size_t capacity)
+	{
+		m_Blocks.reserve(8);
+		AddBlock(capacity);
+	}
+
+	FrameArena::~FrameArena()
+	{
+		FreeBlocks();
+	}
+
+	void* FrameArena::Allocate(const size_t size, const size_t alignment)
+	{
+		Block* block = &m_Blocks.back();
+		uintptr_t address = (reinterpret_cast<uintptr_t>(block->Memory) + m_Offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		size_t end = (size_t)(address - reinterpret_cast<uintptr_t>(block->Memory)) + size;
+
+		if (end > block->Size)
+		{
+			AddBlock(std::max(block->Size * 2, size + alignment));
+			block = &m_Blocks.back();
+			address = (reinterpret_cast<uintptr_t>(block->Memory) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			end = (size_t)(address - reinterpret_cast<uintptr_t>(block->Memory)) + size;
+		}
+
+		m_Offset = end;
+		m_FramePeak = std::max(m_FramePeak, GetUsed());
+		return reinterpret_cast<void*>(address);
+	}
+
+	void FrameArena::Reset()
+	{
+		m_LastFramePeak = m_FramePeak;
+		m_FramePeak = 0;
+
+		if (m_Blocks.size() > 1)
+		{
+			size_t capacity = 0;
+			for (const Block& block : m_Blocks)
+			{
+				capacity += block.Size;
+			}
+
+			FreeBlocks();
+			AddBlock(capacity);
+		}
+
+		m_Offset = 0;
+		m_UsedInPreviousBlocks = 0;
+	}
+
+	size_t FrameArena::GetUsed() const
+	{
+		return m_UsedInPreviousBlocks + m_Offset;
+	}
+
+	size_t FrameArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (const Block& block : m_Blocks)
+		{
+			capacity += block.Size;
+		}
+		return capacity;
+	}
+
+	size_t FrameArena::GetPeakUsage() const
+	{
+		return m_LastFramePeak;
+	}
+
+	uint32_t FrameArena::GetNumHeapAllocations() const
+	{
+		return m_NumHeapAllocations;
+	}
+
+	void FrameArena::AddBlock(const size_t size)
+	{
+		if (!m_Blocks.empty())
+		{
+			m_UsedInPreviousBlocks += m_Offset;
+		}
+
+		Block block;
+		block.Size = size;
+		block.Memory = static_cast<uint8_t*>(::operator new(size, std::align_val_t(BLOCK_ALIGNMENT)));
+		m_Blocks.push_back(block);
+		m_Offset = 0;
+		++m_NumHeapAllocations;
+	}
+
+	void FrameArena::FreeBlocks()
+	{
+		for (const Block& block : m_Blocks)
+		{
+			::operator delete(block.Memory, std::align_val_t(BLOCK_ALIGNMENT));
+		}
+		m_Blocks.clear();
+	}
+
+	void ThreadFrameArenas::BeginFrame()
+	{
+		const size_t numThreads = (size_t)JobSystem::Get().GetNumWorkers() + 1;
+		while (m_Arenas.size() < numThreads)
+		{
+			m_Arenas.push_back(std::make_unique<FrameArena>());
+		}
+	}
+
+	FrameArena& ThreadFrameArenas::GetLocal()
+	{
+		const uint32_t threadIndex = JobSystem::GetThreadIndex();
+		assert(threadIndex < m_Arenas.size() && "ThreadFrameArenas::BeginFrame was not called for this frame");
+		return *m_Arenas[threadIndex];
+	}
+
+	void ThreadFrameArenas::Reset()
+	{
+		for (auto& arena : m_Arenas)
+		{
+			arena->Reset();
+		}
+	}
+
+	size_t ThreadFrameArenas::GetPeakUsage() const
+	{
+		size_t peak = 0;
+		for (const auto& arena : m_Arenas)
+		{
+			peak += arena->GetPeakUsage();
+		}
+		return peak;
+	}
+}
\ No newline at end of file
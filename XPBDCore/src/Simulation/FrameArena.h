@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* Linear allocator for data that only lives for one simulation frame.
+	* Allocations bump an offset and are released all at once by Reset, destructors are never run.
+	* When a frame needs more than the capacity a new block is chained, and Reset merges the blocks
+	* into one, so after the first few frames stepping does not touch the global heap anymore.
+	*/
+	class FrameArena
+	{
+	public:
+		static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+		explicit FrameArena(const size_t capacity = DEFAULT_CAPACITY);
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void* Allocate(const size_t size, const size_t alignment = alignof(std::max_align_t));
+
+		/**
+		* Allocates count value-initialized objects of T.
+		*/
+		template<typename T>
+		T* Allocate(const size_t count);
+
+		/**
+		* Releases every allocation of the frame and records its peak usage.
+		*/
+		void Reset();
+
+		size_t GetUsed() const;
+		size_t GetCapacity() const;
+		// Peak usage of the last completed frame
+		size_t GetPeakUsage() const;
+		// Number of blocks requested from the global heap so far, stays constant once the arena has warmed up.
+		uint32_t GetNumHeapAllocations() const;
+
+	private:
+		struct Block
+		{
+			uint8_t* Memory = nullptr;
+			size_t Size = 0;
+		};
+
+		void AddBlock(const size_t size);
+		void FreeBlocks();
+
+	private:
+		std::vector<Block> m_Blocks;
+		// Offset into the last block, and the bytes used in the blocks before it
+		size_t m_Offset = 0;
+		size_t m_UsedInPreviousBlocks = 0;
+
+		size_t m_FramePeak = 0;
+		size_t m_LastFramePeak = 0;
+		uint32_t m_NumHeapAllocations = 0;
+	};
+
+	template<typename T>
+	T* FrameArena::Allocate(const size_t count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "Frame arena memory is released without running destructors");
+
+		T* items = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		for (size_t i = 0; i < count; ++i)
+		{
+			new (items + i) T();
+		}
+		return items;
+	}
+
+	/**
+	* One FrameArena per job system thread, so jobs can allocate without synchronization.
+	*/
+	class ThreadFrameArenas
+	{
+	public:
+		/**
+		* Makes sure there is an arena for every thread of the job system.
+		* Must be called outside of any ParallelFor, before the arenas are used for the frame.
+		*/
+		void BeginFrame();
+
+		/**
+		* Arena of the calling thread.
+		*/
+		FrameArena& GetLocal();
+
+		void Reset();
+
+		// Sum of the peak usage of all threads in the last completed frame
+		size_t GetPeakUsage() const;
+
+	private:
+		std::vector<std::unique_ptr<FrameArena>> m_Arenas;
+	};
+}
\ No newline at end of file
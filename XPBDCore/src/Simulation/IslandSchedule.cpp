@@ -0,0 +1,119 @@
+#include "IslandSchedule.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Simulation
+{
+	void IslandSchedule::Build(const BodyStore& bodies, const BodyIslands& islands, const std::vector<uint32_t>& numConstraints, const int iterations, const uint64_t minBatchCost)
+	{
+		Islands.clear();
+		BatchStarts.clear();
+		BatchCosts.clear();
+
+		const uint32_t numIslands = (uint32_t)islands.GetNumIslands();
+		m_IslandCosts.resize(numIslands);
+
+		uint64_t totalCost = 0;
+		std::vector<uint32_t>& order = m_Order;
+		order.clear();
+		for (uint32_t island = 0; island < numIslands; ++island)
+		{
+			const uint64_t numBodies = islands.IslandStarts[island + 1] - islands.IslandStarts[island];
+			const uint64_t constraints = island < numConstraints.size() ? numConstraints[island] : 0;
+			// Islands without constraints still integrate their bodies.
+			m_IslandCosts[island] = numBodies * std::max<uint64_t>(constraints, 1) * (uint64_t)std::max(iterations, 1);
+			bool isAwake = false;
+			for (uint32_t i = islands.IslandStarts[island]; i < islands.IslandStarts[island + 1] && !isAwake; ++i)
+			{
+				isAwake = bodies.HasFlag(islands.Bodies[i], BODY_FLAG_ACTIVE);
+			}
+
+			if (isAwake)
+			{
+				order.push_back(island);
+				totalCost += m_IslandCosts[island];
+			}
+		}
+
+		if (order.empty())
+		{
+			BatchStarts.push_back(0);
+			return;
+		}
+
+		// Ties broken by index, so the schedule only depends on the islands
+		std::sort(order.begin(), order.end(), [this](const uint32_t a, const uint32_t b)
+		{
+			return m_IslandCosts[a] != m_IslandCosts[b] ? m_IslandCosts[a] > m_IslandCosts[b] : a < b;
+		});
+
+		// Same bound as the number of chunks JobSystem::Dispatch splits a range into
+		const uint64_t maxBatches = (uint64_t)(JobSystem::Get().GetNumWorkers() + 1) * 4;
+		const uint64_t costBatches = std::max<uint64_t>(totalCost / std::max<uint64_t>(minBatchCost, 1), 1);
+		const uint32_t numBatches = (uint32_t)std::min({ (uint64_t)order.size(), maxBatches, costBatches });
+
+		// Longest processing time first: every island goes to the batch with the smallest load so far.
+		// The loads form a min-heap, the same ordering a priority_queue with std::greater keeps.
+		m_Loads.clear();
+		for (uint32_t batch = 0; batch < numBatches; ++batch)
+		{
+			m_Loads.push_back({ 0, batch });
+		}
+		std::make_heap(m_Loads.begin(), m_Loads.end(), std::greater<BatchLoad>());
+
+		m_IslandBatches.resize(order.size());
+		m_BatchSizes.assign(numBatches, 0);
+		BatchCosts.assign(numBatches, 0);
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			std::pop_heap(m_Loads.begin(), m_Loads.end(), std::greater<BatchLoad>());
+			BatchLoad& load = m_Loads.back();
+
+			m_IslandBatches[i] = load.second;
+			++m_BatchSizes[load.second];
+			load.first += m_IslandCosts[order[i]];
+			BatchCosts[load.second] = load.first;
+			std::push_heap(m_Loads.begin(), m_Loads.end(), std::greater<BatchLoad>());
+		}
+
+		// Batches are dispatched by decreasing cost, a batch keeps its islands largest first.
+		m_BatchOrder.resize(numBatches);
+		for (uint32_t batch = 0; batch < numBatches; ++batch)
+		{
+			m_BatchOrder[batch] = batch;
+		}
+		std::sort(m_BatchOrder.begin(), m_BatchOrder.end(), [this](const uint32_t a, const uint32_t b)
+		{
+			return BatchCosts[a] != BatchCosts[b] ? BatchCosts[a] > BatchCosts[b] : a < b;
+		});
+
+		m_Cursors.resize(numBatches);
+		uint32_t offset = 0;
+		for (const uint32_t batch : m_BatchOrder)
+		{
+			m_Cursors[batch] = offset;
+			BatchStarts.push_back(offset);
+			offset += m_BatchSizes[batch];
+		}
+		BatchStarts.push_back(offset);
+
+		Islands.resize(order.size());
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			Islands[m_Cursors[m_IslandBatches[i]]++] = order[i];
+		}
+
+		m_SortedCosts.resize(numBatches);
+		for (uint32_t i = 0; i < numBatches; ++i)
+		{
+			m_SortedCosts[i] = BatchCosts[m_BatchOrder[i]];
+		}
+		BatchCosts.swap(m_SortedCosts);
+	}
+
+	size_t IslandSchedule::GetNumBatches() const
+	{
+		return BatchStarts.empty() ? 0 : BatchStarts.size() - 1;
+	}
+}
\ No newline at end of file
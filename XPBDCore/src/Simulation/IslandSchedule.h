@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "Simulation/Islands.h"
+#include "Simulation/JobSystem.h"
+
+namespace Simulation
+{
+	/**
+	* Order in which the awake islands are handed to the job system.
+	* Islands are costed as bodies x constraints x iterations and packed largest first into batches,
+	* so a few big islands get a thread each while many small ones share a job.
+	*/
+	struct IslandSchedule
+	{
+		// Island indices grouped by batch, batches ordered by decreasing cost
+		std::vector<uint32_t> Islands;
+		// Offset of each batch into Islands, with one extra entry marking the end.
+		std::vector<uint32_t> BatchStarts;
+		std::vector<uint64_t> BatchCosts;
+
+		/**
+		* numConstraints holds the constraint count of every island. Islands without an active body are left out,
+		* which also picks up bodies woken since the islands were built.
+		* Batches are not split below minBatchCost, which keeps the job overhead small next to the work.
+		*/
+		void Build(const BodyStore& bodies, const BodyIslands& islands, const std::vector<uint32_t>& numConstraints, const int iterations, const uint64_t minBatchCost = 4096);
+
+		size_t GetNumBatches() const;
+
+	private:
+		using BatchLoad = std::pair<uint64_t, uint32_t>;
+
+		// Scratch kept between builds, the schedule is rebuilt every substep
+		std::vector<uint64_t> m_IslandCosts;
+		std::vector<uint32_t> m_Order;
+		std::vector<BatchLoad> m_Loads;
+		std::vector<uint32_t> m_IslandBatches;
+		std::vector<uint32_t> m_BatchSizes;
+		std::vector<uint32_t> m_BatchOrder;
+		std::vector<uint32_t> m_Cursors;
+		std::vector<uint64_t> m_SortedCosts;
+	};
+
+	/**
+	* Calls stepIsland(island) for every scheduled island. Each batch runs as one job and its islands
+	* run in order, islands share no dynamic body so the jobs need no synchronization.
+	*/
+	template<typename TFunc>
+	void RunIslands(const IslandSchedule& schedule, TFunc&& stepIsland)
+	{
+		// A chunk size of one turns every batch into its own job, the thieves take the big ones first.
+		ParallelFor(0, (uint32_t)schedule.GetNumBatches(), [&schedule, &stepIsland](const uint32_t batch)
+		{
+			for (uint32_t i = schedule.BatchStarts[batch]; i < schedule.BatchStarts[batch + 1]; ++i)
+			{
+				stepIsland(schedule.Islands[i]);
+			}
+		}, 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "Islands.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	uint32_t BodyIslands::FindRoot(uint32_t body)
+	{
+		uint32_t root = body;
+		while (m_Parents[root] != root)
+		{
+			root = m_Parents[root];
+		}
+
+		// Path compression, every visited body points at the root afterwards
+		while (m_Parents[body] != root)
+		{
+			const uint32_t next = m_Parents[body];
+			m_Parents[body] = root;
+			body = next;
+		}
+		return root;
+	}
+
+	void BodyIslands::Build(const BodyStore& bodies, const std::vector<ConstraintBodies>& links)
+	{
+		const uint32_t numBodies = (uint32_t)bodies.Size();
+		m_Parents.resize(numBodies);
+		for (uint32_t body = 0; body < numBodies; ++body)
+		{
+			m_Parents[body] = body;
+		}
+
+		for (const ConstraintBodies& link : links)
+		{
+			if (link.Body1 == INVALID_BODY_HANDLE || link.Body2 == INVALID_BODY_HANDLE
+				|| bodies.IsStatic(link.Body1) || bodies.IsStatic(link.Body2))
+			{
+				continue;
+			}
+
+			const uint32_t root1 = FindRoot(link.Body1);
+			const uint32_t root2 = FindRoot(link.Body2);
+			if (root1 != root2)
+			{
+				// Hang the larger handle below the smaller one, so the roots do not depend on the link order
+				m_Parents[std::max(root1, root2)] = std::min(root1, root2);
+			}
+		}
+
+		// Counting sort of the dynamic bodies by island, islands ordered by their smallest body
+		m_IslandIndices.assign(numBodies, INVALID_ISLAND);
+		IslandStarts.clear();
+		for (uint32_t body = 0; body < numBodies; ++body)
+		{
+			if (bodies.IsStatic(body))
+			{
+				continue;
+			}
+
+			const uint32_t root = FindRoot(body);
+			if (m_IslandIndices[root] == INVALID_ISLAND)
+			{
+				m_IslandIndices[root] = (uint32_t)IslandStarts.size();
+				IslandStarts.push_back(0);
+			}
+			++IslandStarts[m_IslandIndices[root]];
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t& start : IslandStarts)
+		{
+			const uint32_t count = start;
+			start = offset;
+			offset += count;
+		}
+		IslandStarts.push_back(offset);
+
+		Bodies.resize(offset);
+		m_Cursors.assign(IslandStarts.begin(), IslandStarts.end() - 1);
+		for (uint32_t body = 0; body < numBodies; ++body)
+		{
+			if (!bodies.IsStatic(body))
+			{
+				Bodies[m_Cursors[m_IslandIndices[FindRoot(body)]]++] = body;
+			}
+		}
+
+		Sleeping.assign(GetNumIslands(), 0);
+	}
+
+	void BodyIslands::UpdateSleeping(BodyStore& bodies, const float deltaTime, const SleepSettings& settings)
+	{
+		m_RestTimes.resize(bodies.Size(), 0.0f);
+
+		const float linearThresholdSq = settings.LinearThreshold * settings.LinearThreshold;
+		const float angularThresholdSq = settings.AngularThreshold * settings.AngularThreshold;
+		for (size_t island = 0; island < GetNumIslands(); ++island)
+		{
+			bool isAwake = false;
+			bool canSleep = true;
+			for (uint32_t i = IslandStarts[island]; i < IslandStarts[island + 1]; ++i)
+			{
+				const BodyHandle body = Bodies[i];
+				if (!bodies.HasFlag(body, BODY_FLAG_ACTIVE))
+				{
+					continue;
+				}
+
+				isAwake = true;
+				const bool isResting = bodies.LinearVelocities[body].squaredNorm() < linearThresholdSq
+					&& bodies.AngularVelocities[body].squaredNorm() < angularThresholdSq;
+				m_RestTimes[body] = isResting ? m_RestTimes[body] + deltaTime : 0.0f;
+				canSleep &= m_RestTimes[body] >= settings.TimeToSleep;
+			}
+
+			// Fully asleep islands stay asleep until a force or an awake body touches them.
+			if (!isAwake)
+			{
+				Sleeping[island] = 1;
+				continue;
+			}
+
+			Sleeping[island] = canSleep ? 1 : 0;
+			for (uint32_t i = IslandStarts[island]; i < IslandStarts[island + 1]; ++i)
+			{
+				const BodyHandle body = Bodies[i];
+				if (canSleep)
+				{
+					bodies.LinearVelocities[body].setZero();
+					bodies.AngularVelocities[body].setZero();
+				}
+				else if (!bodies.HasFlag(body, BODY_FLAG_ACTIVE))
+				{
+					// Woken through the island, it has to rest again on its own before sleeping
+					m_RestTimes[body] = 0.0f;
+				}
+				bodies.SetFlag(body, BODY_FLAG_ACTIVE, !canSleep);
+			}
+		}
+	}
+
+	bool BodyIslands::WakeIsland(BodyStore& bodies, BodyHandle body)
+	{
+		if (bodies.IsStatic(body) || bodies.HasFlag(body, BODY_FLAG_ACTIVE))
+		{
+			return false;
+		}
+
+		const uint32_t island = GetIsland(body);
+		if (island == INVALID_ISLAND)
+		{
+			bodies.WakeUp(body);
+			return true;
+		}
+
+		Sleeping[island] = 0;
+		for (uint32_t i = IslandStarts[island]; i < IslandStarts[island + 1]; ++i)
+		{
+			const BodyHandle islandBody = Bodies[i];
+			bodies.WakeUp(islandBody);
+			// It has to rest again on its own before the island sleeps
+			if (islandBody < m_RestTimes.size())
+			{
+				m_RestTimes[islandBody] = 0.0f;
+			}
+		}
+		return true;
+	}
+
+	size_t BodyIslands::GetNumIslands() const
+	{
+		return IslandStarts.empty() ? 0 : IslandStarts.size() - 1;
+	}
+
+	uint32_t BodyIslands::GetIsland(BodyHandle body) const
+	{
+		// Build compressed every path, so a dynamic body points straight at its root.
+		return body < m_Parents.size() ? m_IslandIndices[m_Parents[body]] : INVALID_ISLAND;
+	}
+
+	size_t BodyIslands::GetNumSleepingBodies() const
+	{
+		size_t numSleeping = 0;
+		for (size_t island = 0; island < GetNumIslands(); ++island)
+		{
+			numSleeping += Sleeping[island] ? IslandStarts[island + 1] - IslandStarts[island] : 0;
+		}
+		return numSleeping;
+	}
+}
\ No newline at end of file
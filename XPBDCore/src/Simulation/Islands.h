@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Simulation/BodyStore.h"
+#include "Simulation/ConstraintColoring.h"
+
+namespace Simulation
+{
+	constexpr uint32_t INVALID_ISLAND = UINT32_MAX;
+
+	struct SleepSettings
+	{
+		// Bodies slower than these count as resting
+		float LinearThreshold = 0.05f;
+		float AngularThreshold = 0.05f;
+		// Seconds every body of an island has to rest before the island sleeps
+		float TimeToSleep = 0.5f;
+	};
+
+	/**
+	* Groups the dynamic bodies into islands: sets of bodies linked by constraints or contacts, found with union-find.
+	* Static bodies never link two islands, since the solver does not move them.
+	* Sleeping bodies have BODY_FLAG_ACTIVE cleared and are skipped by the integrators, solvers and velocity passes.
+	*/
+	struct BodyIslands
+	{
+		// Body handles grouped by island
+		std::vector<BodyHandle> Bodies;
+		// Offset of each island into Bodies, with one extra entry marking the end.
+		std::vector<uint32_t> IslandStarts;
+		// One entry per island, non zero while the island sleeps
+		std::vector<uint8_t> Sleeping;
+
+		void Build(const BodyStore& bodies, const std::vector<ConstraintBodies>& links);
+
+		/**
+		* Call once per frame after Build. Islands with an awake body wake up as a whole,
+		* islands whose bodies all rested for settings.TimeToSleep go to sleep with zero velocities.
+		*/
+		void UpdateSleeping(BodyStore& bodies, const float deltaTime, const SleepSettings& settings);
+
+		/**
+		* Wakes the whole island of the body right away, so it is solved in the current substep.
+		* Bodies added since the last Build only wake themselves. Returns true if anything woke up.
+		*/
+		bool WakeIsland(BodyStore& bodies, BodyHandle body);
+
+		size_t GetNumIslands() const;
+		size_t GetNumSleepingBodies() const;
+
+		/**
+		* Island of the body at the last Build, INVALID_ISLAND for static bodies and bodies added since.
+		*/
+		uint32_t GetIsland(BodyHandle body) const;
+
+	private:
+		uint32_t FindRoot(uint32_t body);
+
+	private:
+		std::vector<uint32_t> m_Parents;
+		std::vector<uint32_t> m_IslandIndices;
+		std::vector<uint32_t> m_Cursors;
+		// Seconds each body has been resting, indexed by body handle
+		std::vector<float> m_RestTimes;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "JacobiCorrections.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	void JacobiCorrections::Build(const BodyStore& bodies, const std::vector<ConstraintBodies>& constraintBodies)
+	{
+		const uint32_t numConstraints = (uint32_t)constraintBodies.size();
+		const uint32_t numBodies = (uint32_t)bodies.Size();
+
+		Corrections.resize(numConstraints);
+
+		// Counting sort of the constraint ends by body
+		m_BodyStarts.assign(numBodies + 1, 0);
+		for (const ConstraintBodies& constraint : constraintBodies)
+		{
+			if (constraint.Body1 != INVALID_BODY_HANDLE)
+			{
+				++m_BodyStarts[constraint.Body1 + 1];
+			}
+			if (constraint.Body2 != INVALID_BODY_HANDLE)
+			{
+				++m_BodyStarts[constraint.Body2 + 1];
+			}
+		}
+
+		for (uint32_t body = 0; body < numBodies; ++body)
+		{
+			m_BodyStarts[body + 1] += m_BodyStarts[body];
+		}
+
+		m_BodyConstraints.resize(m_BodyStarts[numBodies]);
+		m_Cursors.assign(m_BodyStarts.begin(), m_BodyStarts.end() - 1);
+		for (uint32_t i = 0; i < numConstraints; ++i)
+		{
+			if (constraintBodies[i].Body1 != INVALID_BODY_HANDLE)
+			{
+				m_BodyConstraints[m_Cursors[constraintBodies[i].Body1]++] = (i << 1);
+			}
+			if (constraintBodies[i].Body2 != INVALID_BODY_HANDLE)
+			{
+				m_BodyConstraints[m_Cursors[constraintBodies[i].Body2]++] = (i << 1) | 1;
+			}
+		}
+	}
+
+	void JacobiCorrections::Reset()
+	{
+		std::fill(Corrections.begin(), Corrections.end(), ConstraintCorrection{});
+	}
+
+	void JacobiCorrections::Apply(BodyStore& bodies, const float relaxation) const
+	{
+		using namespace Eigen;
+
+		const uint32_t numBodies = (uint32_t)m_BodyStarts.size() - 1;
+		ParallelFor(0, numBodies, [this, &bodies, relaxation](const BodyHandle body)
+		{
+			const uint32_t start = m_BodyStarts[body];
+			const uint32_t end = m_BodyStarts[body + 1];
+			if (start == end || !bodies.IsSimulated(body))
+			{
+				return;
+			}
+
+			Vector3f deltaPosition = Vector3f::Zero();
+			Vector3f deltaRotation = Vector3f::Zero();
+			for (uint32_t k = start; k < end; ++k)
+			{
+				const ConstraintCorrection& correction = Corrections[m_BodyConstraints[k] >> 1];
+				const bool isBody2 = (m_BodyConstraints[k] & 1) != 0;
+				deltaPosition += isBody2 ? correction.Position2 : correction.Position1;
+				deltaRotation += isBody2 ? correction.Rotation2 : correction.Rotation1;
+			}
+
+			const float scale = relaxation / (float)(end - start);
+			bodies.Positions[body] += scale * deltaPosition;
+
+			if (bodies.CanCorrectRotation(body))
+			{
+				deltaRotation *= scale;
+				Quaternionf& rotation = bodies.Rotations[body];
+				rotation.coeffs() += 0.5f * (Quaternionf(0.0f, deltaRotation.x(), deltaRotation.y(), deltaRotation.z()) * rotation).coeffs();
+				rotation.normalize();
+				// Every body is updated by exactly one job, refresh here so the next iteration can read the cache concurrently.
+				bodies.UpdateTransformCache(body);
+			}
+		});
+	}
+}
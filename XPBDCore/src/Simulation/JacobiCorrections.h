@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "Simulation/BodyStore.h"
+#include "Simulation/ConstraintColoring.h"
+#include "Simulation/JobSystem.h"
+
+namespace Simulation
+{
+	enum class SolverMode : uint8_t
+	{
+		GaussSeidel = 0,
+		Jacobi,
+	};
+
+	/**
+	* Corrections a single constraint wants to apply to its two bodies during a Jacobi iteration.
+	* Rotations are stored as rotation vectors, applied as q += 0.5 * [dr, 0] * q.
+	*/
+	struct ConstraintCorrection
+	{
+		Eigen::Vector3f Position1 = Eigen::Vector3f::Zero();
+		Eigen::Vector3f Position2 = Eigen::Vector3f::Zero();
+		Eigen::Vector3f Rotation1 = Eigen::Vector3f::Zero();
+		Eigen::Vector3f Rotation2 = Eigen::Vector3f::Zero();
+	};
+
+	/**
+	* Jacobi solve support for a constraint array.
+	* Each constraint writes into its own ConstraintCorrection, so the solve needs no ordering or coloring.
+	* Apply then averages the corrections of every body over the constraints touching it.
+	*/
+	struct JacobiCorrections
+	{
+		// One entry per constraint
+		std::vector<ConstraintCorrection> Corrections;
+
+		void Build(const BodyStore& bodies, const std::vector<ConstraintBodies>& constraintBodies);
+
+		void Reset();
+
+		/**
+		* Moves every dynamic body by the average of its corrections scaled by relaxation.
+		* Relaxation above 1 over-relaxes and helps convergence on densely connected graphs.
+		*/
+		void Apply(BodyStore& bodies, const float relaxation) const;
+
+	private:
+		// Constraints touching each body, entries are (constraint index << 1) | side.
+		std::vector<uint32_t> m_BodyStarts;
+		std::vector<uint32_t> m_BodyConstraints;
+
+		std::vector<uint32_t> m_Cursors;
+	};
+}
@@ -0,0 +1,242 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	namespace
+	{
+		// Index of the queue owned by the current thread, 0 for every thread outside the pool.
+		thread_local uint32_t t_QueueIndex = 0;
+
+		// Enough for a few nested dispatches of (workers + 1) * 4 chunks before a queue has to grow
+		constexpr uint32_t INITIAL_QUEUE_CAPACITY = 256;
+	}
+
+	JobSystem& JobSystem::Get()
+	{
+		static JobSystem jobSystem(GetDefaultNumWorkers());
+		return jobSystem;
+	}
+
+	JobSystem::JobSystem(const uint32_t numWorkers)
+	{
+		Start(numWorkers);
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::SetNumWorkers(const uint32_t numWorkers)
+	{
+		if (m_Running && numWorkers == GetNumWorkers())
+		{
+			return;
+		}
+
+		Shutdown();
+		Start(numWorkers);
+	}
+
+	uint32_t JobSystem::GetNumWorkers() const
+	{
+		return (uint32_t)m_Workers.size();
+	}
+
+	uint32_t JobSystem::GetDefaultNumWorkers()
+	{
+		// Leave one core to the main thread, which helps while it waits.
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return t_QueueIndex;
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!m_Running)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+			m_Running = false;
+		}
+		m_WakeCondition.notify_all();
+
+		for (std::thread& worker : m_Workers)
+		{
+			worker.join();
+		}
+
+		m_Workers.clear();
+		m_Queues.clear();
+		m_QueuedJobs = 0;
+	}
+
+	void JobSystem::Dispatch(const uint32_t begin, const uint32_t end, const uint32_t minChunkSize, JobFunction function, void* context)
+	{
+		if (m_Workers.empty())
+		{
+			function(context, begin, end);
+			return;
+		}
+
+		// A few chunks per thread so that stealing can even out uneven chunks.
+		const uint32_t count = end - begin;
+		const uint32_t maxChunks = (GetNumWorkers() + 1) * 4;
+		const uint32_t numChunks = std::min(maxChunks, (count + minChunkSize - 1) / std::max(1u, minChunkSize));
+		const uint32_t chunkSize = (count + numChunks - 1) / numChunks;
+
+		std::atomic<uint32_t> remaining{ 0 };
+		const uint32_t queueIndex = GetQueueIndex();
+		for (uint32_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize)
+		{
+			Job job;
+			job.Function = function;
+			job.Context = context;
+			job.Begin = chunkBegin;
+			job.End = std::min(end, chunkBegin + chunkSize);
+			job.Remaining = &remaining;
+
+			remaining.fetch_add(1, std::memory_order_relaxed);
+			Push(queueIndex, job);
+		}
+
+		{
+			// Taking the lock orders the push against a worker that is about to sleep.
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+		}
+		m_WakeCondition.notify_all();
+
+		// Help out until every chunk of this dispatch finished. Jobs of other dispatches may run here too.
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			if (!TryRunJob(queueIndex))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::Start(const uint32_t numWorkers)
+	{
+		m_Queues.clear();
+		for (uint32_t i = 0; i < numWorkers + 1; ++i)
+		{
+			m_Queues.push_back(std::make_unique<WorkerQueue>());
+			m_Queues.back()->Jobs.resize(INITIAL_QUEUE_CAPACITY);
+		}
+
+		m_Running = true;
+
+		m_Workers.reserve(numWorkers);
+		for (uint32_t i = 0; i < numWorkers; ++i)
+		{
+			m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+		}
+	}
+
+	void JobSystem::WorkerLoop(const uint32_t queueIndex)
+	{
+		t_QueueIndex = queueIndex;
+
+		while (m_Running)
+		{
+			if (TryRunJob(queueIndex))
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_WakeCondition.wait(lock, [this]()
+			{
+				return m_QueuedJobs.load() > 0 || !m_Running;
+			});
+		}
+	}
+
+	void JobSystem::Push(const uint32_t queueIndex, const Job& job)
+	{
+		WorkerQueue& queue = *m_Queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		const uint32_t capacity = (uint32_t)queue.Jobs.size();
+		if (queue.Count == capacity)
+		{
+			// Unroll the ring into a buffer twice the size
+			std::vector<Job> jobs(std::max(capacity * 2, INITIAL_QUEUE_CAPACITY));
+			for (uint32_t i = 0; i < queue.Count; ++i)
+			{
+				jobs[i] = queue.Jobs[(queue.Head + i) % capacity];
+			}
+			queue.Jobs.swap(jobs);
+			queue.Head = 0;
+		}
+
+		queue.Jobs[(queue.Head + queue.Count) % queue.Jobs.size()] = job;
+		++queue.Count;
+		m_QueuedJobs.fetch_add(1);
+	}
+
+	bool JobSystem::Pop(const uint32_t queueIndex, Job& job)
+	{
+		WorkerQueue& queue = *m_Queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		if (queue.Count == 0)
+		{
+			return false;
+		}
+
+		--queue.Count;
+		job = queue.Jobs[(queue.Head + queue.Count) % queue.Jobs.size()];
+		m_QueuedJobs.fetch_sub(1);
+		return true;
+	}
+
+	bool JobSystem::Steal(const uint32_t thiefIndex, Job& job)
+	{
+		const uint32_t numQueues = (uint32_t)m_Queues.size();
+		for (uint32_t offset = 1; offset < numQueues; ++offset)
+		{
+			WorkerQueue& queue = *m_Queues[(thiefIndex + offset) % numQueues];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (queue.Count == 0)
+			{
+				continue;
+			}
+
+			// Steal from the opposite end to the owner, those are the jobs it would run last.
+			job = queue.Jobs[queue.Head];
+			queue.Head = (queue.Head + 1) % (uint32_t)queue.Jobs.size();
+			--queue.Count;
+			m_QueuedJobs.fetch_sub(1);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool JobSystem::TryRunJob(const uint32_t queueIndex)
+	{
+		Job job;
+		if (!Pop(queueIndex, job) && !Steal(queueIndex, job))
+		{
+			return false;
+		}
+
+		job.Function(job.Context, job.Begin, job.End);
+		job.Remaining->fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	uint32_t JobSystem::GetQueueIndex() const
+	{
+		return t_QueueIndex;
+	}
+}
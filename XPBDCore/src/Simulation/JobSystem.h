@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Simulation
+{
+	/**
+	* Work-stealing thread pool shared by the solver loops.
+	* Every worker and the main thread own a double ended queue; they pop their own jobs from the back
+	* and steal from the front of the others once they run dry.
+	* Threads live until Shutdown, so substeps do not pay for thread start-up.
+	*/
+	class JobSystem
+	{
+	public:
+		using JobFunction = void(*)(void* context, uint32_t begin, uint32_t end);
+
+		static JobSystem& Get();
+
+		~JobSystem();
+
+		/**
+		* Restarts the pool with the given number of worker threads (the calling thread always helps as well).
+		* Must not be called while a ParallelFor is running.
+		*/
+		void SetNumWorkers(const uint32_t numWorkers);
+		uint32_t GetNumWorkers() const;
+
+		static uint32_t GetDefaultNumWorkers();
+
+		/**
+		* Index of the calling thread in the pool, 1..NumWorkers for workers and 0 for every other thread.
+		*/
+		static uint32_t GetThreadIndex();
+
+		void Shutdown();
+
+		/**
+		* Splits [begin, end) into chunks of at least minChunkSize, runs them on the pool and
+		* returns once all of them finished. The caller keeps executing jobs while it waits,
+		* so ParallelFor can be nested inside a job.
+		*/
+		void Dispatch(const uint32_t begin, const uint32_t end, const uint32_t minChunkSize, JobFunction function, void* context);
+
+	private:
+		struct Job
+		{
+			JobFunction Function = nullptr;
+			void* Context = nullptr;
+			uint32_t Begin = 0;
+			uint32_t End = 0;
+			std::atomic<uint32_t>* Remaining = nullptr;
+		};
+
+		/**
+		* Ring buffer of jobs. It grows when full and never shrinks, so once warmed up
+		* dispatching does not touch the heap, unlike a deque that frees its blocks as it drains.
+		*/
+		struct WorkerQueue
+		{
+			std::mutex Mutex;
+			std::vector<Job> Jobs;
+			uint32_t Head = 0;
+			uint32_t Count = 0;
+		};
+
+	private:
+		explicit JobSystem(const uint32_t numWorkers);
+
+		void Start(const uint32_t numWorkers);
+		void WorkerLoop(const uint32_t queueIndex);
+
+		void Push(const uint32_t queueIndex, const Job& job);
+		bool Pop(const uint32_t queueIndex, Job& job);
+		bool Steal(const uint32_t thiefIndex, Job& job);
+		bool TryRunJob(const uint32_t queueIndex);
+
+		uint32_t GetQueueIndex() const;
+
+	private:
+		// Queue 0 belongs to the threads that are not workers (the main thread).
+		std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+		std::vector<std::thread> m_Workers;
+
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+		std::atomic<uint32_t> m_QueuedJobs{ 0 };
+		std::atomic<bool> m_Running{ false };
+	};
+
+	/**
+	* Runs func(i) for every i in [begin, end) on the job system.
+	* Ranges no larger than minChunkSize are run inline on the calling thread.
+	*/
+	template<typename TFunc>
+	void ParallelFor(const uint32_t begin, const uint32_t end, TFunc&& func, const uint32_t minChunkSize = 256)
+	{
+		if (end <= begin)
+		{
+			return;
+		}
+
+		if (end - begin <= minChunkSize)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				func(i);
+			}
+			return;
+		}
+
+		using TFuncType = std::remove_reference_t<TFunc>;
+		JobSystem::Get().Dispatch(begin, end, minChunkSize,
+			[](void* context, const uint32_t chunkBegin, const uint32_t chunkEnd)
+			{
+				TFuncType& chunkFunc = *static_cast<TFuncType*>(context);
+				for (uint32_t i = chunkBegin; i < chunkEnd; ++i)
+				{
+					chunkFunc(i);
+				}
+			},
+			(void*)&func);
+	}
+
+
+	/**
+	* Reduces [begin, end) in blocks of blockSize: mapBlock(blockBegin, blockEnd) runs on the job system,
+	* combine(result, blockResult) folds the block results on the calling thread in block order.
+	* The blocks do not depend on the number of workers, so neither does the result, floating point included.
+	* blockResults holds the block results, callers that reduce every step keep it around so it stops allocating.
+	*/
+	template<typename T, typename TMap, typename TCombine>
+	T ParallelReduce(const uint32_t begin, const uint32_t end, const uint32_t blockSize, T identity, std::vector<T>& blockResults, TMap&& mapBlock, TCombine&& combine)
+	{
+		if (end <= begin)
+		{
+			return identity;
+		}
+
+		const uint32_t numBlocks = (end - begin + blockSize - 1) / blockSize;
+		blockResults.assign(numBlocks, identity);
+		ParallelFor(0, numBlocks, [&](const uint32_t block)
+		{
+			const uint32_t blockBegin = begin + block * blockSize;
+			blockResults[block] = mapBlock(blockBegin, blockBegin + blockSize < end ? blockBegin + blockSize : end);
+		}, 1);
+
+		T result = identity;
+		for (const T& blockResult : blockResults)
+		{
+			result = combine(result, blockResult);
+		}
+		return result;
+	}
+}
@@ -0,0 +1,201 @@
+#include "PhysicsScene.h"
+#include "Simulation/BodyIntegrator.h"
+#include "Simulation/StateHash.h"
+
+#include <algorithm>
+
+namespace Simulation
+{
+	namespace
+	{
+		// Frames slower than this many fixed steps drop the rest of their time instead of falling further behind.
+		constexpr int MAX_FIXED_STEPS_PER_FRAME = 8;
+	}
+
+	void PhysicsScene::Simulate(const float deltaTime)
+	{
+		float dt = deltaTime;
+		if (m_Deterministic)
+		{
+			m_Accumulator += deltaTime;
+			int numSteps = 0;
+			while (m_Accumulator >= m_FixedDeltaTime && numSteps < MAX_FIXED_STEPS_PER_FRAME)
+			{
+				Step();
+				m_Accumulator -= m_FixedDeltaTime;
+				++numSteps;
+			}
+
+			if (numSteps == MAX_FIXED_STEPS_PER_FRAME)
+			{
+				m_Accumulator = std::min(m_Accumulator, m_FixedDeltaTime);
+			}
+		}
+		else if (m_OverrideDeltaTime)
+		{
+			while (m_Accumulator > m_DeltaTime)
+			{
+				HandleXPBDLoop(m_DeltaTime);
+				m_Accumulator -= m_DeltaTime;
+			}
+			m_Accumulator += deltaTime;
+		}
+		else
+		{
+			HandleXPBDLoop(dt);
+		}
+	}
+
+	void PhysicsScene::Step()
+	{
+		HandleXPBDLoop(m_FixedDeltaTime);
+		++m_StepCount;
+		m_StateHash = m_Deterministic ? HashBodyState(m_Bodies, m_BlockHashes) : 0;
+	}
+
+	void PhysicsScene::SetDeterministic(const bool deterministic)
+	{
+		if (deterministic != m_Deterministic)
+		{
+			m_Deterministic = deterministic;
+			m_Accumulator = 0.0f;
+			m_StateHash = deterministic ? HashBodyState(m_Bodies, m_BlockHashes) : 0;
+		}
+	}
+
+	bool PhysicsScene::IsDeterministic() const
+	{
+		return m_Deterministic;
+	}
+
+	void PhysicsScene::SetFixedDeltaTime(const float fixedDeltaTime)
+	{
+		m_FixedDeltaTime = fixedDeltaTime;
+	}
+
+	float PhysicsScene::GetFixedDeltaTime() const
+	{
+		return m_FixedDeltaTime;
+	}
+
+	uint64_t PhysicsScene::GetStateHash() const
+	{
+		return m_StateHash;
+	}
+
+	uint64_t PhysicsScene::GetStepCount() const
+	{
+		return m_StepCount;
+	}
+
+	void PhysicsScene::ResetSteps()
+	{
+		m_Accumulator = 0.0f;
+		m_StepCount = 0;
+		m_StateHash = m_Deterministic ? HashBodyState(m_Bodies, m_BlockHashes) : 0;
+	}
+
+	int PhysicsScene::GetSubsteps() const
+	{
+		return m_Substeps;
+	}
+
+	int PhysicsScene::GetNumPosIterations() const
+	{
+		return m_NumPosIterations;
+	}
+
+	void PhysicsScene::SetSubsteps(const int substeps)
+	{
+		m_Substeps = substeps;
+	}
+
+	void PhysicsScene::SetNumPosIterations(const int numPosIterations)
+	{
+		m_NumPosIterations = numPosIterations;
+	}
+
+	SolverMode PhysicsScene::GetSolverMode() const
+	{
+		return m_SolverMode;
+	}
+
+	float PhysicsScene::GetRelaxation() const
+	{
+		return m_Relaxation;
+	}
+
+	void PhysicsScene::SetSolverMode(const SolverMode solverMode)
+	{
+		m_SolverMode = solverMode;
+	}
+
+	void PhysicsScene::SetRelaxation(const float relaxation)
+	{
+		m_Relaxation = relaxation;
+	}
+
+	BodyStore& PhysicsScene::GetBodies()
+	{
+		return m_Bodies;
+	}
+
+	const BodyStore& PhysicsScene::GetBodies() const
+	{
+		return m_Bodies;
+	}
+
+	const std::vector<ContactManifold>& PhysicsScene::GetContacts() const
+	{
+		return m_Contacts;
+	}
+
+	FrameArena& PhysicsScene::GetFrameArena()
+	{
+		return m_FrameArena;
+	}
+
+	ThreadFrameArenas& PhysicsScene::GetThreadFrameArenas()
+	{
+		return m_ThreadFrameArenas;
+	}
+
+	size_t PhysicsScene::GetFrameArenaPeakUsage() const
+	{
+		return m_FrameArena.GetPeakUsage() + m_ThreadFrameArenas.GetPeakUsage();
+	}
+
+	void PhysicsScene::OnUpdatePosition(const float substepTime)
+	{
+		IntegrateBodies(m_Bodies, substepTime);
+	}
+
+	void PhysicsScene::OnPostSolveConstraints(const float substepTime)
+	{
+		DeriveVelocities(m_Bodies, substepTime);
+	}
+
+	void PhysicsScene::HandleXPBDLoop(const float deltaTime)
+	{
+		m_ThreadFrameArenas.BeginFrame();
+
+		OnStartSimulationFrame();
+
+		const float subStepTime = deltaTime / (float)m_Substeps;
+		for (int i = 0; i < m_Substeps; ++i)
+		{
+			OnUpdatePosition(subStepTime);
+			// Rotations only change through the solvers from here on, which keep the cache up to date.
+			m_Bodies.UpdateTransformCache();
+			OnDetectCollisions(subStepTime);
+			OnSolveConstraints(subStepTime);
+			OnPostSolveConstraints(subStepTime);
+			OnSolveVelocities(subStepTime);
+		}
+
+		OnEndSimulationFrame();
+
+		m_FrameArena.Reset();
+		m_ThreadFrameArenas.Reset();
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "Collision/ContactManifold.h"
+#include "Simulation/BodyStore.h"
+#include "Simulation/FrameArena.h"
+#include "Simulation/JacobiCorrections.h"
+
+namespace Simulation
+{
+	/**
+	* Owns the simulated bodies and runs the XPBD substep loop.
+	* Has no rendering dependencies, so it can be stepped without a window.
+	*/
+	class PhysicsScene
+	{
+	public:
+		PhysicsScene() = default;
+		virtual ~PhysicsScene() = default;
+
+		virtual void Simulate(const float deltaTime);
+
+		/**
+		* Runs a single step of the fixed delta time, whatever mode the scene is in.
+		* Regression runs drive the scene with this and compare GetStateHash after every step.
+		*/
+		void Step();
+
+		/**
+		* Deterministic mode steps the fixed delta time out of an accumulator, so the frame time only changes
+		* how many steps run, and hashes the body state after every step. The solvers visit the constraints
+		* in a fixed order and reduce in fixed blocks, so the same inputs give bitwise identical steps
+		* on any number of threads. Across compilers and SIMD widths this also needs the strictfp build.
+		*/
+		void SetDeterministic(const bool deterministic);
+		bool IsDeterministic() const;
+
+		void SetFixedDeltaTime(const float fixedDeltaTime);
+		float GetFixedDeltaTime() const;
+
+		// Hash of the body state after the last step, or when deterministic mode was turned on. 0 outside deterministic mode.
+		uint64_t GetStateHash() const;
+		uint64_t GetStepCount() const;
+		/**
+		* Clears the accumulator, the step count and the hash. Call when the scene is reset.
+		*/
+		void ResetSteps();
+
+		int GetSubsteps() const;
+		int GetNumPosIterations() const;
+
+		void SetSubsteps(const int substeps);
+		void SetNumPosIterations(const int numPosIterations);
+
+		SolverMode GetSolverMode() const;
+		float GetRelaxation() const;
+
+		void SetSolverMode(const SolverMode solverMode);
+		void SetRelaxation(const float relaxation);
+
+		BodyStore& GetBodies();
+		const BodyStore& GetBodies() const;
+		// Contact manifolds found in the last substep, empty in scenes without collisions
+		const std::vector<ContactManifold>& GetContacts() const;
+
+		/**
+		* Transient memory for the current frame, released after OnEndSimulationFrame.
+		*/
+		FrameArena& GetFrameArena();
+		ThreadFrameArenas& GetThreadFrameArenas();
+		// Bytes used by the frame arenas in the last simulated frame, main thread and jobs combined
+		size_t GetFrameArenaPeakUsage() const;
+
+	protected:
+		// Updates
+		virtual void OnStartSimulationFrame() = 0;
+		// Defaults to IntegrateBodies, scenes with their own integration override it
+		virtual void OnUpdatePosition(const float substepTime);
+		// Broadphase and narrowphase, runs on the integrated positions right before the constraints are solved
+		virtual void OnDetectCollisions(const float) {}
+		virtual void OnSolveConstraints(const float substepTime) = 0;
+		// Defaults to DeriveVelocities
+		virtual void OnPostSolveConstraints(const float substepTime);
+		// Velocity level corrections on the velocities derived in OnPostSolveConstraints: restitution, friction and damping
+		virtual void OnSolveVelocities(const float) {}
+		virtual void OnEndSimulationFrame() = 0;
+
+	private:
+		void HandleXPBDLoop(const float deltaTime);
+
+	protected:
+		BodyStore m_Bodies;
+		std::vector<ContactManifold> m_Contacts;
+
+		FrameArena m_FrameArena;
+		ThreadFrameArenas m_ThreadFrameArenas;
+
+		bool m_OverrideDeltaTime = false;
+		float m_DeltaTime = 0.0f;
+		float m_Accumulator = 0.0f;
+
+		bool m_Deterministic = false;
+		float m_FixedDeltaTime = 1.0f / 60.0f;
+		uint64_t m_StateHash = 0;
+		uint64_t m_StepCount = 0;
+		std::vector<uint64_t> m_BlockHashes;
+
+		int m_Substeps = 8;
+		int m_NumPosIterations = 1;
+
+		SolverMode m_SolverMode = SolverMode::GaussSeidel;
+		// Over-relaxation factor for the averaged Jacobi corrections
+		float m_Relaxation = 1.0f;
+	};
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+
+/**
+* Thin wrapper over the SIMD registers used by the batched constraint kernels.
+* Builds with AVX2 enabled get 8 lanes, every other x64 build falls back to 4 SSE2 lanes.
+* Comparisons return all-ones/all-zeros lanes that are consumed by Select.
+*/
+namespace Simulation::Simd
+{
+#if defined(__AVX2__)
+	constexpr uint32_t LANE_WIDTH = 8;
+
+	struct FloatLanes
+	{
+		__m256 Value;
+
+		FloatLanes() = default;
+		FloatLanes(__m256 value) : Value(value) {}
+		explicit FloatLanes(float value) : Value(_mm256_set1_ps(value)) {}
+	};
+
+	inline FloatLanes Set1(const float value) { return _mm256_set1_ps(value); }
+	inline FloatLanes Zero() { return _mm256_setzero_ps(); }
+	inline FloatLanes Load(const float* data) { return _mm256_loadu_ps(data); }
+	inline void Store(float* data, const FloatLanes a) { _mm256_storeu_ps(data, a.Value); }
+
+	inline FloatLanes operator+(const FloatLanes a, const FloatLanes b) { return _mm256_add_ps(a.Value, b.Value); }
+	inline FloatLanes operator-(const FloatLanes a, const FloatLanes b) { return _mm256_sub_ps(a.Value, b.Value); }
+	inline FloatLanes operator*(const FloatLanes a, const FloatLanes b) { return _mm256_mul_ps(a.Value, b.Value); }
+	inline FloatLanes operator/(const FloatLanes a, const FloatLanes b) { return _mm256_div_ps(a.Value, b.Value); }
+	inline FloatLanes operator-(const FloatLanes a) { return _mm256_xor_ps(a.Value, _mm256_set1_ps(-0.0f)); }
+
+	inline FloatLanes operator&(const FloatLanes a, const FloatLanes b) { return _mm256_and_ps(a.Value, b.Value); }
+	inline FloatLanes operator|(const FloatLanes a, const FloatLanes b) { return _mm256_or_ps(a.Value, b.Value); }
+	inline FloatLanes AndNot(const FloatLanes mask, const FloatLanes a) { return _mm256_andnot_ps(mask.Value, a.Value); }
+
+	inline FloatLanes operator>(const FloatLanes a, const FloatLanes b) { return _mm256_cmp_ps(a.Value, b.Value, _CMP_GT_OQ); }
+	inline FloatLanes operator<=(const FloatLanes a, const FloatLanes b) { return _mm256_cmp_ps(a.Value, b.Value, _CMP_LE_OQ); }
+
+	inline FloatLanes Sqrt(const FloatLanes a) { return _mm256_sqrt_ps(a.Value); }
+	inline FloatLanes Max(const FloatLanes a, const FloatLanes b) { return _mm256_max_ps(a.Value, b.Value); }
+
+	inline FloatLanes Select(const FloatLanes mask, const FloatLanes a, const FloatLanes b) { return _mm256_blendv_ps(b.Value, a.Value, mask.Value); }
+	inline bool AnyTrue(const FloatLanes mask) { return _mm256_movemask_ps(mask.Value) != 0; }
+	inline uint32_t MaskBits(const FloatLanes mask) { return (uint32_t)_mm256_movemask_ps(mask.Value); }
+#else
+	constexpr uint32_t LANE_WIDTH = 4;
+
+	struct FloatLanes
+	{
+		__m128 Value;
+
+		FloatLanes() = default;
+		FloatLanes(__m128 value) : Value(value) {}
+		explicit FloatLanes(float value) : Value(_mm_set1_ps(value)) {}
+	};
+
+	inline FloatLanes Set1(const float value) { return _mm_set1_ps(value); }
+	inline FloatLanes Zero() { return _mm_setzero_ps(); }
+	inline FloatLanes Load(const float* data) { return _mm_loadu_ps(data); }
+	inline void Store(float* data, const FloatLanes a) { _mm_storeu_ps(data, a.Value); }
+
+	inline FloatLanes operator+(const FloatLanes a, const FloatLanes b) { return _mm_add_ps(a.Value, b.Value); }
+	inline FloatLanes operator-(const FloatLanes a, const FloatLanes b) { return _mm_sub_ps(a.Value, b.Value); }
+	inline FloatLanes operator*(const FloatLanes a, const FloatLanes b) { return _mm_mul_ps(a.Value, b.Value); }
+	inline FloatLanes operator/(const FloatLanes a, const FloatLanes b) { return _mm_div_ps(a.Value, b.Value); }
+	inline FloatLanes operator-(const FloatLanes a) { return _mm_xor_ps(a.Value, _mm_set1_ps(-0.0f)); }
+
+	inline FloatLanes operator&(const FloatLanes a, const FloatLanes b) { return _mm_and_ps(a.Value, b.Value); }
+	inline FloatLanes operator|(const FloatLanes a, const FloatLanes b) { return _mm_or_ps(a.Value, b.Value); }
+	inline FloatLanes AndNot(const FloatLanes mask, const FloatLanes a) { return _mm_andnot_ps(mask.Value, a.Value); }
+
+	inline FloatLanes operator>(const FloatLanes a, const FloatLanes b) { return _mm_cmpgt_ps(a.Value, b.Value); }
+	inline FloatLanes operator<=(const FloatLanes a, const FloatLanes b) { return _mm_cmple_ps(a.Value, b.Value); }
+
+	inline FloatLanes Sqrt(const FloatLanes a) { return _mm_sqrt_ps(a.Value); }
+	inline FloatLanes Max(const FloatLanes a, const FloatLanes b) { return _mm_max_ps(a.Value, b.Value); }
+
+	// SSE2 has no blend, mask lanes are all ones or all zeros so and/andnot does the same.
+	inline FloatLanes Select(const FloatLanes mask, const FloatLanes a, const FloatLanes b) { return _mm_or_ps(_mm_and_ps(mask.Value, a.Value), _mm_andnot_ps(mask.Value, b.Value)); }
+	inline bool AnyTrue(const FloatLanes mask) { return _mm_movemask_ps(mask.Value) != 0; }
+	inline uint32_t MaskBits(const FloatLanes mask) { return (uint32_t)_mm_movemask_ps(mask.Value); }
+#endif
+
+	inline FloatLanes& operator+=(FloatLanes& a, const FloatLanes b) { a = a + b; return a; }
+	inline FloatLanes& operator-=(FloatLanes& a, const FloatLanes b) { a = a - b; return a; }
+	inline FloatLanes& operator*=(FloatLanes& a, const FloatLanes b) { a = a * b; return a; }
+
+	/**
+	* Loads lane i from data[indices[i] * stride + offset].
+	* Used to pull body state stored as arrays of structs into lanes.
+	*/
+	inline FloatLanes Gather(const float* data, const uint32_t* indices, const uint32_t stride, const uint32_t offset)
+	{
+		alignas(32) float values[LANE_WIDTH];
+		for (uint32_t lane = 0; lane < LANE_WIDTH; ++lane)
+		{
+			values[lane] = data[indices[lane] * stride + offset];
+		}
+		return Load(values);
+	}
+
+	/**
+	* Stores lane i to data[indices[i] * stride + offset], the inverse of Gather.
+	*/
+	inline void Scatter(float* data, const uint32_t* indices, const uint32_t stride, const uint32_t offset, const FloatLanes a)
+	{
+		alignas(32) float values[LANE_WIDTH];
+		Store(values, a);
+		for (uint32_t lane = 0; lane < LANE_WIDTH; ++lane)
+		{
+			data[indices[lane] * stride + offset] = values[lane];
+		}
+	}
+
+	template<typename T>
+	struct LaneTraits;
+
+	template<>
+	struct LaneTraits<float>
+	{
+		using Mask = bool;
+	};
+
+	template<>
+	struct LaneTraits<FloatLanes>
+	{
+		using Mask = FloatLanes;
+	};
+
+	// Scalar versions of the lane operations, so the kernels below can also run one constraint at a time.
+	inline float Sqrt(const float a) { return std::sqrt(a); }
+	inline float Max(const float a, const float b) { return a > b ? a : b; }
+	inline float Select(const bool mask, const float a, const float b) { return mask ? a : b; }
+
+	template<typename T>
+	struct Vector3T
+	{
+		T X;
+		T Y;
+		T Z;
+	};
+
+	template<typename T>
+	inline Vector3T<T> operator+(const Vector3T<T>& a, const Vector3T<T>& b) { return { a.X + b.X, a.Y + b.Y, a.Z + b.Z }; }
+	template<typename T>
+	inline Vector3T<T> operator-(const Vector3T<T>& a, const Vector3T<T>& b) { return { a.X - b.X, a.Y - b.Y, a.Z - b.Z }; }
+	template<typename T>
+	inline Vector3T<T> operator-(const Vector3T<T>& a) { return { -a.X, -a.Y, -a.Z }; }
+	template<typename T>
+	inline Vector3T<T> operator*(const T s, const Vector3T<T>& a) { return { s * a.X, s * a.Y, s * a.Z }; }
+	template<typename T>
+	inline Vector3T<T> operator/(const Vector3T<T>& a, const T s) { return { a.X / s, a.Y / s, a.Z / s }; }
+
+	template<typename T>
+	inline T Dot(const Vector3T<T>& a, const Vector3T<T>& b)
+	{
+		return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+	}
+
+	template<typename T>
+	inline Vector3T<T> Cross(const Vector3T<T>& a, const Vector3T<T>& b)
+	{
+		return {
+			a.Y * b.Z - a.Z * b.Y,
+			a.Z * b.X - a.X * b.Z,
+			a.X * b.Y - a.Y * b.X };
+	}
+
+	template<typename T, typename TMask>
+	inline Vector3T<T> Select(const TMask mask, const Vector3T<T>& a, const Vector3T<T>& b)
+	{
+		return { Select(mask, a.X, b.X), Select(mask, a.Y, b.Y), Select(mask, a.Z, b.Z) };
+	}
+
+	/**
+	* Row-major 3x3 matrix.
+	*/
+	template<typename T>
+	struct Matrix3T
+	{
+		T M[9];
+	};
+
+	template<typename T>
+	inline Vector3T<T> operator*(const Matrix3T<T>& m, const Vector3T<T>& v)
+	{
+		return {
+			m.M[0] * v.X + m.M[1] * v.Y + m.M[2] * v.Z,
+			m.M[3] * v.X + m.M[4] * v.Y + m.M[5] * v.Z,
+			m.M[6] * v.X + m.M[7] * v.Y + m.M[8] * v.Z };
+	}
+
+	template<typename T>
+	struct QuaternionT
+	{
+		T X;
+		T Y;
+		T Z;
+		T W;
+	};
+
+	/**
+	* Rotates v by the unit quaternion q.
+	*/
+	template<typename T>
+	inline Vector3T<T> Rotate(const QuaternionT<T>& q, const Vector3T<T>& v)
+	{
+		// v' = v + w * t + q x t, with t = 2 * (q x v)
+		const Vector3T<T> axis{ q.X, q.Y, q.Z };
+		const Vector3T<T> t = T(2.0f) * Cross(axis, v);
+		return v + q.W * t + Cross(axis, t);
+	}
+
+	/**
+	* q += 0.5 * [delta, 0] * q followed by a normalize, the XPBD rotation correction.
+	*/
+	template<typename T>
+	inline QuaternionT<T> ApplyRotationCorrection(const QuaternionT<T>& q, const Vector3T<T>& delta)
+	{
+		const T half = T(0.5f);
+		QuaternionT<T> result;
+		result.X = q.X + half * (delta.X * q.W + delta.Y * q.Z - delta.Z * q.Y);
+		result.Y = q.Y + half * (delta.Y * q.W + delta.Z * q.X - delta.X * q.Z);
+		result.Z = q.Z + half * (delta.Z * q.W + delta.X * q.Y - delta.Y * q.X);
+		result.W = q.W - half * (delta.X * q.X + delta.Y * q.Y + delta.Z * q.Z);
+
+		const T length = Sqrt(result.X * result.X + result.Y * result.Y + result.Z * result.Z + result.W * result.W);
+		result.X = result.X / length;
+		result.Y = result.Y / length;
+		result.Z = result.Z / length;
+		result.W = result.W / length;
+		return result;
+	}
+
+	template<typename T, typename TMask>
+	inline QuaternionT<T> Select(const TMask mask, const QuaternionT<T>& a, const QuaternionT<T>& b)
+	{
+		return { Select(mask, a.X, b.X), Select(mask, a.Y, b.Y), Select(mask, a.Z, b.Z), Select(mask, a.W, b.W) };
+	}
+
+	using Vector3Lanes = Vector3T<FloatLanes>;
+	using Matrix3Lanes = Matrix3T<FloatLanes>;
+	using QuaternionLanes = QuaternionT<FloatLanes>;
+}
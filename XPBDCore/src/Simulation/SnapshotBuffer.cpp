@@ -0,0 +1,93 @@
+#include "SnapshotBuffer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Simulation
+{
+	void TransformSnapshot::Capture(const BodyStore& bodies, const std::vector<Eigen::Vector3f>& forces, const std::vector<ContactManifold>& contacts, const uint64_t step)
+	{
+		// Assigning keeps the capacity, after the first few steps the copies stop allocating.
+		Positions.assign(bodies.Positions.begin(), bodies.Positions.end());
+		Rotations.assign(bodies.Rotations.begin(), bodies.Rotations.end());
+		Scales.assign(bodies.Scales.begin(), bodies.Scales.end());
+		Flags.assign(bodies.Flags.begin(), bodies.Flags.end());
+		Forces.assign(forces.begin(), forces.end());
+		Contacts.assign(contacts.begin(), contacts.end());
+		Step = step;
+	}
+
+	TransformSnapshot& SnapshotBuffer::BeginWrite()
+	{
+		return m_Slots[m_Back];
+	}
+
+	void SnapshotBuffer::Publish()
+	{
+		// Release makes the writes to the back slot visible to the reader that picks it up.
+		m_Back = m_Middle.exchange(m_Back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	bool SnapshotBuffer::Acquire()
+	{
+		if ((m_Middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+		{
+			return false;
+		}
+
+		// The old front becomes the previous snapshot, its slot (now holding the older previous) goes back to the writer.
+		std::swap(m_Previous, m_Slots[m_Front]);
+		m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+
+	const TransformSnapshot& SnapshotBuffer::GetCurrent() const
+	{
+		return m_Slots[m_Front];
+	}
+
+	const TransformSnapshot& SnapshotBuffer::GetPrevious() const
+	{
+		return m_Previous;
+	}
+
+	void SnapshotBuffer::Reset()
+	{
+		for (TransformSnapshot& slot : m_Slots)
+		{
+			slot.Positions.clear();
+			slot.Rotations.clear();
+			slot.Scales.clear();
+			slot.Flags.clear();
+			slot.Forces.clear();
+			slot.Contacts.clear();
+			slot.Step = 0;
+		}
+		m_Previous = TransformSnapshot{};
+
+		m_Back = 0;
+		m_Middle.store(1, std::memory_order_relaxed);
+		m_Front = 2;
+	}
+
+	void InterpolateSnapshots(const TransformSnapshot& previous, const TransformSnapshot& current, const float alpha,
+		std::vector<Eigen::Vector3f>& positions, std::vector<Eigen::Quaternionf>& rotations)
+	{
+		const size_t numBodies = current.Positions.size();
+		const size_t numPrevious = std::min(previous.Positions.size(), numBodies);
+		positions.resize(numBodies);
+		rotations.resize(numBodies);
+
+		for (size_t body = 0; body < numPrevious; ++body)
+		{
+			positions[body] = previous.Positions[body] + alpha * (current.Positions[body] - previous.Positions[body]);
+			rotations[body] = previous.Rotations[body].slerp(alpha, current.Rotations[body]);
+		}
+
+		for (size_t body = numPrevious; body < numBodies; ++body)
+		{
+			positions[body] = current.Positions[body];
+			rotations[body] = current.Rotations[body];
+		}
+	}
+}
\ No newline at end of file
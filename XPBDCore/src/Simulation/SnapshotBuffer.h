@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "Collision/ContactManifold.h"
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* Body transforms at the end of one simulation step, copied out for the renderer.
+	* Carries the debug data drawn with them too, so the renderer never reads the bodies the simulation is stepping.
+	*/
+	struct TransformSnapshot
+	{
+		std::vector<Eigen::Vector3f> Positions;
+		std::vector<Eigen::Quaternionf> Rotations;
+		std::vector<Eigen::Vector3f> Scales;
+		std::vector<uint8_t> Flags;
+		// Net force of every body over the step. The scenes clear the forces before the step ends, so they record them for this.
+		std::vector<Eigen::Vector3f> Forces;
+		std::vector<ContactManifold> Contacts;
+		// Steps the scene had taken when the snapshot was captured
+		uint64_t Step = 0;
+
+		void Capture(const BodyStore& bodies, const std::vector<Eigen::Vector3f>& forces, const std::vector<ContactManifold>& contacts, const uint64_t step);
+	};
+
+	/**
+	* Lock-free triple buffer handing snapshots from the simulation thread to the render thread.
+	* The writer fills its back slot and swaps it with the shared middle slot, the reader swaps the middle
+	* slot with its front slot whenever a newer snapshot is waiting. Neither side ever waits for the other,
+	* and no slot is touched by both threads at once.
+	* The reader keeps the snapshot it held before the last swap, so it can interpolate between the last two.
+	*/
+	class SnapshotBuffer
+	{
+	public:
+		// Writer side: fill the slot returned by BeginWrite, then Publish it.
+		TransformSnapshot& BeginWrite();
+		void Publish();
+
+		/**
+		* Reader side. Returns true when a newer snapshot replaced the current one.
+		*/
+		bool Acquire();
+		const TransformSnapshot& GetCurrent() const;
+		const TransformSnapshot& GetPrevious() const;
+
+		/**
+		* Drops every snapshot. Neither thread may use the buffer meanwhile.
+		*/
+		void Reset();
+
+	private:
+		static constexpr uint8_t INDEX_MASK = 0x3;
+		// Set in the middle index while the middle slot holds a snapshot the reader has not seen yet
+		static constexpr uint8_t FRESH_BIT = 0x4;
+
+		std::array<TransformSnapshot, 3> m_Slots;
+		TransformSnapshot m_Previous;
+
+		std::atomic<uint8_t> m_Middle{ 1 };
+		uint8_t m_Back = 0;
+		uint8_t m_Front = 2;
+	};
+
+	/**
+	* Blends the transforms of two snapshots, alpha 0 giving previous and 1 giving current.
+	* Bodies missing from previous take their current transform.
+	*/
+	void InterpolateSnapshots(const TransformSnapshot& previous, const TransformSnapshot& current, const float alpha,
+		std::vector<Eigen::Vector3f>& positions, std::vector<Eigen::Quaternionf>& rotations);
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "StateHash.h"
+#include "Simulation/JobSystem.h"
+
+#include <cstring>
+
+namespace Simulation
+{
+	namespace
+	{
+		// 64-bit FNV-1a, fed with 32-bit words instead of bytes
+		constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+		constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+		constexpr uint32_t HASH_BLOCK_SIZE = 1024;
+
+		inline uint64_t HashWord(const uint64_t hash, const uint32_t word)
+		{
+			return (hash ^ word) * FNV_PRIME;
+		}
+
+		inline uint64_t HashFloats(uint64_t hash, const float* values, const uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t word;
+				std::memcpy(&word, &values[i], sizeof(word));
+				hash = HashWord(hash, word);
+			}
+			return hash;
+		}
+	}
+
+	uint64_t HashBodyState(const BodyStore& bodies)
+	{
+		std::vector<uint64_t> blockHashes;
+		return HashBodyState(bodies, blockHashes);
+	}
+
+	uint64_t HashBodyState(const BodyStore& bodies, std::vector<uint64_t>& blockHashes)
+	{
+		const uint64_t stateHash = ParallelReduce<uint64_t>(0, (uint32_t)bodies.Size(), HASH_BLOCK_SIZE, FNV_OFFSET_BASIS, blockHashes,
+			[&bodies](const uint32_t begin, const uint32_t end)
+			{
+				uint64_t hash = FNV_OFFSET_BASIS;
+				for (BodyHandle body = begin; body < end; ++body)
+				{
+					hash = HashFloats(hash, bodies.Positions[body].data(), 3);
+					hash = HashFloats(hash, bodies.Rotations[body].coeffs().data(), 4);
+					hash = HashFloats(hash, bodies.LinearVelocities[body].data(), 3);
+					hash = HashFloats(hash, bodies.AngularVelocities[body].data(), 3);
+					hash = HashWord(hash, bodies.Flags[body]);
+				}
+				return hash;
+			},
+			[](const uint64_t hash, const uint64_t blockHash)
+			{
+				// Chaining the block hashes through the prime keeps their order significant.
+				return HashWord(HashWord(hash, (uint32_t)blockHash), (uint32_t)(blockHash >> 32));
+			});
+
+		// The body count, so appending a body at rest still changes the hash
+		return HashWord(stateHash, (uint32_t)bodies.Size());
+	}
+}
\ No newline at end of file
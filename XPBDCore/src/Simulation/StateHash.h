@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Simulation/BodyStore.h"
+
+namespace Simulation
+{
+	/**
+	* 64-bit hash of the simulated state of every body: positions, rotations, velocities and flags.
+	* Hashes the bit patterns, so any difference shows up, down to the sign of a zero.
+	* Bodies are hashed in fixed blocks combined in order, the result does not depend on the number of threads.
+	*/
+	uint64_t HashBodyState(const BodyStore& bodies);
+
+	/**
+	* Same hash, with the block hashes kept in blockHashes so hashing every step does not allocate.
+	*/
+	uint64_t HashBodyState(const BodyStore& bodies, std::vector<uint64_t>& blockHashes);
+}
\ No newline at end of file
@@ -1,5 +1,15 @@
 include "Dependencies.lua"
 
+newoption {
+   trigger = "avx2",
+   description = "Build the batched solver kernels with 8-wide AVX2 lanes instead of 4-wide SSE"
+}
+
+newoption {
+   trigger = "strictfp",
+   description = "Disable floating point contraction so the batched kernels match the scalar solvers bit for bit"
+}
+
 workspace "XPBDSandbox"
    configurations { "Debug", "Release" }
    architecture "x86_64"
@@ -12,7 +22,9 @@ objectPath = basedir .. "bin-int/" .. outputdir
 debugPath =  basedir 
 
 group "Core"
+   include "XPBDCore"
    include "Engine"
+   include "XPBDBench"
 group ""
 
 group "Dependencies"